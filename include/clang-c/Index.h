@@ -19,6 +19,7 @@
 #include <time.h>
 
 #include "clang-c/Platform.h"
+#include "clang-c/CXCompilationDatabase.h"
 #include "clang-c/CXString.h"
 
 /**
@@ -30,7 +31,7 @@
  * compatible, thus CINDEX_VERSION_MAJOR is expected to remain stable.
  */
 #define CINDEX_VERSION_MAJOR 0
-#define CINDEX_VERSION_MINOR 20
+#define CINDEX_VERSION_MINOR 24
 
 #define CINDEX_VERSION_ENCODE(major, minor) ( \
       ((major) * 10000)                       \
@@ -1151,7 +1152,29 @@ enum CXTranslationUnit_Flags {
    * included into the set of code completions returned from this translation
    * unit.
    */
-  CXTranslationUnit_IncludeBriefCommentsInCodeCompletion = 0x80
+  CXTranslationUnit_IncludeBriefCommentsInCodeCompletion = 0x80,
+
+  /**
+   * \brief Used to indicate that an out-of-date precompiled preamble should
+   * continue to be used, rather than rebuilt, when reparsing the translation
+   * unit or performing code completion.
+   *
+   * The precompiled preamble is out-of-date when one of the files it
+   * includes has changed. Continuing to use it avoids blocking on
+   * precompiling the preamble again, at the cost of results that reflect the
+   * previous contents of those files; \c clang_isPreambleStale() reports
+   * when this happened. Pass \c CXReparse_RebuildPreamble to
+   * \c clang_reparseTranslationUnit(), e.g., when the client is idle, to
+   * bring the preamble up-to-date.
+   *
+   * Only changes made through unsaved files are deferred. When a file
+   * included by the preamble changed on disk, the preamble is rebuilt, since
+   * its source locations no longer match the contents of that file.
+   *
+   * This option only has an effect together with
+   * \c CXTranslationUnit_PrecompiledPreamble.
+   */
+  CXTranslationUnit_DeferPreambleRebuild = 0x200
 };
 
 /**
@@ -1321,7 +1344,14 @@ enum CXReparse_Flags {
   /**
    * \brief Used to indicate that no special reparsing options are needed.
    */
-  CXReparse_None = 0x0
+  CXReparse_None = 0x0,
+
+  /**
+   * \brief Used to indicate that an out-of-date precompiled preamble should
+   * be rebuilt, even if the translation unit was parsed with
+   * \c CXTranslationUnit_DeferPreambleRebuild.
+   */
+  CXReparse_RebuildPreamble = 0x1
 };
  
 /**
@@ -1379,6 +1409,18 @@ CINDEX_LINKAGE int clang_reparseTranslationUnit(CXTranslationUnit TU,
                                           struct CXUnsavedFile *unsaved_files,
                                                 unsigned options);
 
+/**
+ * \brief Determine whether the most recent parse, reparse or code completion
+ * of the given translation unit used an out-of-date precompiled preamble.
+ *
+ * This can only happen for translation units parsed with
+ * \c CXTranslationUnit_DeferPreambleRebuild.
+ *
+ * \returns non-zero if the precompiled preamble was out-of-date, zero
+ * otherwise.
+ */
+CINDEX_LINKAGE unsigned clang_isPreambleStale(CXTranslationUnit TU);
+
 /**
   * \brief Categorizes how memory is being used by a translation unit.
   */
@@ -1397,12 +1439,22 @@ enum CXTUResourceUsageKind {
   CXTUResourceUsage_PreprocessingRecord = 12,
   CXTUResourceUsage_SourceManager_DataStructures = 13,
   CXTUResourceUsage_Preprocessor_HeaderSearch = 14,
+  CXTUResourceUsage_AST_Stmts = 15,
+  CXTUResourceUsage_AST_TypeSourceInfo = 16,
   CXTUResourceUsage_MEMORY_IN_BYTES_BEGIN = CXTUResourceUsage_AST,
   CXTUResourceUsage_MEMORY_IN_BYTES_END =
-    CXTUResourceUsage_Preprocessor_HeaderSearch,
+    CXTUResourceUsage_AST_TypeSourceInfo,
+
+  /**
+   * \brief The kinds in this range break down the memory reported by
+   * CXTUResourceUsage_AST. Their amounts are already part of that entry and
+   * must not be added to it when computing a total.
+   */
+  CXTUResourceUsage_AST_BREAKDOWN_BEGIN = CXTUResourceUsage_AST_Stmts,
+  CXTUResourceUsage_AST_BREAKDOWN_END = CXTUResourceUsage_AST_TypeSourceInfo,
 
   CXTUResourceUsage_First = CXTUResourceUsage_AST,
-  CXTUResourceUsage_Last = CXTUResourceUsage_Preprocessor_HeaderSearch
+  CXTUResourceUsage_Last = CXTUResourceUsage_AST_TypeSourceInfo
 };
 
 /**
@@ -5788,6 +5840,37 @@ CINDEX_LINKAGE int clang_indexSourceFile(CXIndexAction,
                                          CXTranslationUnit *out_TU,
                                          unsigned TU_options);
 
+/**
+ * \brief Index a batch of compile commands, such as those returned by
+ * #clang_CompilationDatabase_getAllCompileCommands, one after another via
+ * callbacks implemented through #IndexerCallbacks.
+ *
+ * Each command is indexed like a call to #clang_indexSourceFile, run in the
+ * working directory of the command. The commands are indexed serially, in
+ * order: all callbacks for a translation unit are delivered before the next
+ * command is processed, starting with \c enteredMainFile, so clients can
+ * consume results as they are produced and need no synchronization. Clients
+ * that want to index in parallel can call this function from several threads
+ * with disjoint batches.
+ *
+ * The translation units of a batch share the results of file system 'stat'
+ * calls; files are assumed not to change while the batch is indexed. With
+ * \c CXIndexOpt_SkipParsedBodiesInSession, bodies parsed by earlier commands
+ * of the batch are skipped by the later ones.
+ *
+ * \returns the number of compile commands that could not be indexed.
+ *
+ * The remaining parameters are the same as #clang_indexSourceFile.
+ */
+CINDEX_LINKAGE unsigned
+clang_indexCompileCommandsSerially(CXIndexAction,
+                                   CXClientData client_data,
+                                   IndexerCallbacks *index_callbacks,
+                                   unsigned index_callbacks_size,
+                                   unsigned index_options,
+                                   CXCompileCommands commands,
+                                   unsigned TU_options);
+
 /**
  * \brief Index the given translation unit via callbacks implemented through
  * #IndexerCallbacks.
@@ -5832,6 +5915,92 @@ CINDEX_LINKAGE void clang_indexLoc_getFileLocation(CXIdxLoc loc,
 CINDEX_LINKAGE
 CXSourceLocation clang_indexLoc_getCXSourceLocation(CXIdxLoc loc);
 
+/**
+ * \brief A persistent, on-disk store of the declarations and references
+ * found by indexing.
+ *
+ * The store maps the USR of each entity to its occurrences in source files,
+ * so that queries can be answered without re-parsing. Occurrences are
+ * recorded per source file and translation unit, so translation units that
+ * include a header in different configurations each keep their own record
+ * of it. When a translation unit is re-indexed because one of its files
+ * changed, its records are rewritten, and its records of files that no
+ * longer have any occurrences are removed. Records of other translation
+ * units are not affected.
+ */
+typedef void *CXIndexStore;
+
+/**
+ * \brief Open the index store in directory \p path, creating it if needed.
+ *
+ * \returns the store, or NULL if the directory could not be created.
+ * Must be freed by \c clang_IndexStore_dispose.
+ */
+CINDEX_LINKAGE CXIndexStore clang_IndexStore_create(const char *path);
+
+/**
+ * \brief Release the in-memory resources of an index store. The on-disk
+ * contents are kept.
+ */
+CINDEX_LINKAGE void clang_IndexStore_dispose(CXIndexStore);
+
+/**
+ * \brief Describes the outcome of #clang_IndexStore_indexSourceFile.
+ */
+typedef enum {
+  /**
+   * \brief The translation unit was indexed and the store was updated.
+   */
+  CXIndexStore_Indexed = 0,
+  /**
+   * \brief None of the files that the translation unit depended on changed
+   * since it was last indexed with the same arguments, so it was not
+   * re-indexed.
+   */
+  CXIndexStore_UpToDate = 1,
+  /**
+   * \brief The translation unit could not be indexed.
+   */
+  CXIndexStore_Failure = 2
+} CXIndexStoreResult;
+
+/**
+ * \brief Index the given source file into the store, unless the store is
+ * already up-to-date with respect to it.
+ *
+ * The parameters are the same as for #clang_indexSourceFile.
+ */
+CINDEX_LINKAGE CXIndexStoreResult
+clang_IndexStore_indexSourceFile(CXIndexStore, CXIndexAction,
+                                 const char *source_filename,
+                                 const char * const *command_line_args,
+                                 int num_command_line_args,
+                                 unsigned TU_options);
+
+/**
+ * \brief Visitor invoked for each occurrence of an entity in the store.
+ *
+ * \param isDefinitionOrDeclaration non-zero if the occurrence declares the
+ * entity, zero if it references it.
+ */
+typedef enum CXVisitorResult
+    (*CXIndexStoreOccurrenceVisitor)(void *context, const char *filename,
+                                     unsigned line, unsigned column,
+                                     int isDeclaration);
+
+/**
+ * \brief Find all recorded occurrences of the entity with the given USR.
+ *
+ * Occurrences are visited in order of file and position. An occurrence
+ * recorded by several translation units is visited once.
+ *
+ * \returns one of the CXResult enumerators.
+ */
+CINDEX_LINKAGE CXResult
+clang_IndexStore_findOccurrences(CXIndexStore, const char *USR,
+                                 void *context,
+                                 CXIndexStoreOccurrenceVisitor visitor);
+
 /**
  * @}
  */
@@ -170,6 +170,24 @@ class ASTContext : public RefCountedBase<ASTContext> {
   llvm::DenseMap<const MaterializeTemporaryExpr*, APValue>
     MaterializedTemporaryValues;
 
+  /// \brief The memoized result of a call to a constexpr function.
+  class ConstexprCallResult : public llvm::FoldingSetNode {
+    llvm::FoldingSetNodeID Call;
+
+  public:
+    APValue Value;
+
+    ConstexprCallResult(const llvm::FoldingSetNodeID &Call,
+                        const APValue &Value)
+      : Call(Call), Value(Value) { }
+
+    void Profile(llvm::FoldingSetNodeID &ID) const { ID = Call; }
+  };
+
+  /// \brief Memoized results of calls to constexpr functions, keyed by the
+  /// profile of the callee and the argument values.
+  llvm::FoldingSet<ConstexprCallResult> ConstexprCallResults;
+
   /// \brief Representation of a "canonical" template template parameter that
   /// is used in canonical template names.
   class CanonicalTemplateTemplateParm : public llvm::FoldingSetNode {
@@ -391,6 +409,14 @@ private:
   /// \brief Allocator for partial diagnostics.
   PartialDiagnostic::StorageAllocator DiagAllocator;
 
+  /// \brief The number of bytes of the AST arena used for statements and
+  /// expressions, including their trailing storage and operand arrays.
+  mutable size_t StmtAllocatedMemory;
+
+  /// \brief The number of bytes of the AST arena used for type source
+  /// information.
+  mutable size_t TypeSourceInfoAllocatedMemory;
+
   /// \brief The current C++ ABI.
   OwningPtr<CXXABI> ABI;
   CXXABI *createCXXABI(const TargetInfo &T);
@@ -406,6 +432,7 @@ private:
   friend class ASTReader;
   friend class ASTWriter;
   friend class CXXRecordDecl;
+  friend class InitListExpr;
 
   const TargetInfo *Target;
   clang::PrintingPolicy PrintingPolicy;
@@ -474,12 +501,31 @@ public:
     return BumpAlloc.Allocate(Size, Align);
   }
   void Deallocate(void *Ptr) const { }
+
+  /// Allocate memory for a statement or expression, or for storage that it
+  /// owns, and count it towards getStmtAllocatedMemory().
+  void *AllocateStmt(size_t Size, unsigned Align = 8) const {
+    StmtAllocatedMemory += Size;
+    return BumpAlloc.Allocate(Size, Align);
+  }
+  /// Allocate an array of \p Num elements owned by a statement or expression.
+  template <typename T> T *AllocateStmtArray(size_t Num) const {
+    return new (AllocateStmt(sizeof(T) * Num, llvm::alignOf<T>())) T[Num];
+  }
   
   /// Return the total amount of physical memory allocated for representing
   /// AST nodes and type information.
   size_t getASTAllocatedMemory() const {
     return BumpAlloc.getTotalMemory();
   }
+  /// Return the amount of memory of the AST arena used for statements and
+  /// expressions, including their trailing storage and operand arrays.
+  size_t getStmtAllocatedMemory() const { return StmtAllocatedMemory; }
+  /// Return the amount of memory of the AST arena used for type source
+  /// information.
+  size_t getTypeSourceInfoAllocatedMemory() const {
+    return TypeSourceInfoAllocatedMemory;
+  }
   /// Return the total memory used for various side tables.
   size_t getSideTableAllocatedMemory() const;
   
@@ -2158,6 +2204,16 @@ public:
   APValue *getMaterializedTemporaryValue(const MaterializeTemporaryExpr *E,
                                          bool MayCreate);
 
+  /// \brief Get the memoized result of a call to a constexpr function, given
+  /// the profile of the callee and the argument values, or null if there is
+  /// none.
+  const APValue *getConstexprCallResult(const llvm::FoldingSetNodeID &Call);
+
+  /// \brief Memoize the result of a call to a constexpr function. The result
+  /// must depend only on the callee and the argument values.
+  void setConstexprCallResult(const llvm::FoldingSetNodeID &Call,
+                              const APValue &Value);
+
   //===--------------------------------------------------------------------===//
   //                    Statistics
   //===--------------------------------------------------------------------===//
@@ -2203,6 +2259,13 @@ public:
   /// \brief The number of implicitly-declared destructors for which 
   /// declarations were built.
   static unsigned NumImplicitDestructorsDeclared;
+
+  /// \brief The number of constexpr function call results memoized.
+  static unsigned NumConstexprCallResults;
+
+  /// \brief The number of constexpr function calls whose result was found
+  /// among the memoized ones.
+  static unsigned NumConstexprCallResultsReused;
   
 private:
   ASTContext(const ASTContext &) LLVM_DELETED_FUNCTION;
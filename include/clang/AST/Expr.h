@@ -3748,6 +3748,10 @@ class InitListExpr : public Expr {
   ///  field within the union will be initialized.
   llvm::PointerUnion<Expr *, FieldDecl *> ArrayFillerOrUnionFieldInit;
 
+  /// \brief Count the storage of InitExprs towards the statement memory of
+  /// \p C if it was reallocated since it had \p OldCapacity elements.
+  void noteInitExprsGrowth(const ASTContext &C, size_t OldCapacity);
+
 public:
   InitListExpr(const ASTContext &C, SourceLocation lbraceloc,
                ArrayRef<Expr*> initExprs, SourceLocation rbraceloc);
@@ -0,0 +1,71 @@
+//===- DataflowWorklist.h - Worklist of CFG blocks for dataflow -*- C++ --*-==//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file defines DataflowWorklist, the worklist of CFG blocks shared by the
+// dataflow analyses over source-level CFGs.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_DATAFLOW_WORKLIST
+#define LLVM_CLANG_DATAFLOW_WORKLIST
+
+#include "clang/Analysis/Analyses/PostOrderCFGView.h"
+#include "clang/Basic/LLVM.h"
+#include "llvm/ADT/BitVector.h"
+#include "llvm/ADT/SmallVector.h"
+#include <queue>
+
+namespace clang {
+
+/// \brief A worklist of CFG blocks for dataflow analyses.
+///
+/// Blocks are dequeued in the order in which the analysis converges fastest:
+/// reverse post order for forward analyses, and post order for backward
+/// analyses. A block is in the worklist at most once.
+class DataflowWorklist {
+public:
+  enum Direction { Forward, Backward };
+
+private:
+  /// Orders the blocks so that the one to dequeue first is the greatest.
+  class BlockPriority {
+    PostOrderCFGView::BlockOrderCompare Compare;
+    Direction Dir;
+  public:
+    BlockPriority(const PostOrderCFGView &POV, Direction Dir)
+      : Compare(POV.getComparator()), Dir(Dir) {}
+
+    bool operator()(const CFGBlock *B1, const CFGBlock *B2) const {
+      // BlockOrderCompare puts the blocks later in post order first.
+      return Dir == Backward ? Compare(B1, B2) : Compare(B2, B1);
+    }
+  };
+
+  std::priority_queue<const CFGBlock *, SmallVector<const CFGBlock *, 20>,
+                      BlockPriority> Worklist;
+  llvm::BitVector EnqueuedBlocks;
+
+public:
+  DataflowWorklist(const CFG &cfg, const PostOrderCFGView &POV, Direction Dir)
+    : Worklist(BlockPriority(POV, Dir)),
+      EnqueuedBlocks(cfg.getNumBlockIDs()) {}
+
+  /// Adds \p Block to the worklist, unless it is null or already there.
+  void enqueueBlock(const CFGBlock *Block);
+  void enqueueSuccessors(const CFGBlock *Block);
+  void enqueuePredecessors(const CFGBlock *Block);
+
+  /// Removes and returns the next block to analyze, or null if the worklist
+  /// is empty.
+  const CFGBlock *dequeue();
+};
+
+} // end namespace clang
+
+#endif
@@ -117,6 +117,11 @@ struct UninitVariablesAnalysisStats {
   unsigned NumBlockVisits;
 };
 
+/// Returns true if \p dc declares any variable that the uninitialized values
+/// analysis tracks. If it does not, the analysis has nothing to report and the
+/// CFG does not need to be built for it.
+bool hasTrackedUninitializedVariables(const DeclContext &dc);
+
 void runUninitializedVariablesAnalysis(const DeclContext &dc, const CFG &cfg,
                                        AnalysisDeclContext &ac,
                                        UninitVariablesHandler &handler,
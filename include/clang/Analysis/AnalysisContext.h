@@ -397,6 +397,12 @@ class AnalysisDeclContextManager {
 
   ContextMap Contexts;
   LocationContextManager LocContexts;
+
+  /// The value of UseCounter when the context of each Decl was last returned
+  /// by getContext.
+  llvm::DenseMap<const Decl *, unsigned> LastUse;
+  unsigned UseCounter;
+
   CFG::BuildOptions cfgBuildOptions;
   
   /// Flag to indicate whether or not bodies should be synthesized
@@ -452,6 +458,12 @@ public:
   /// Discard all previously created AnalysisDeclContexts.
   void clear();
 
+  /// Discard the least recently used AnalysisDeclContexts, so that at most
+  /// \p MaxContexts remain. The remaining contexts keep their CFGs and
+  /// analyses, which then need not be rebuilt when the same Decls are
+  /// analyzed again. Returns the number of discarded contexts.
+  unsigned clearLeastRecentlyUsed(unsigned MaxContexts);
+
 private:
   friend class AnalysisDeclContext;
 
@@ -30,6 +30,7 @@
 #include "llvm/ADT/OwningPtr.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringSet.h"
 #include "llvm/Support/Path.h"
 #include <cassert>
 #include <map>
@@ -228,6 +229,10 @@ private:
   /// the preamble must be thrown away.
   llvm::StringMap<std::pair<off_t, time_t> > FilesInPreamble;
 
+  /// \brief The files in \c FilesInPreamble whose contents were overridden
+  /// (via remapping or unsaved files) when the preamble was computed.
+  llvm::StringSet<> OverriddenFilesInPreamble;
+
   /// \brief When non-NULL, this is the buffer used to store the contents of
   /// the main file when it has been padded for use with the precompiled
   /// preamble.
@@ -260,6 +265,15 @@ private:
   /// \brief True if non-system source files should be treated as volatile
   /// (likely to change while trying to use them).
   bool UserFilesAreVolatile : 1;
+
+  /// \brief Whether an out-of-date precompiled preamble should continue to
+  /// be used, rather than rebuilt, when reparsing or performing code
+  /// completion.
+  bool DeferPreambleRebuild : 1;
+
+  /// \brief Whether the most recent parse or code completion used a
+  /// precompiled preamble built from files that changed since.
+  bool PreambleIsStale : 1;
  
   /// \brief The language options used when we load an AST file.
   LangOptions ASTFileLangOpts;
@@ -391,7 +405,8 @@ private:
   llvm::MemoryBuffer *getMainBufferWithPrecompiledPreamble(
                                const CompilerInvocation &PreambleInvocationIn,
                                                      bool AllowRebuild = true,
-                                                        unsigned MaxLines = 0);
+                                                        unsigned MaxLines = 0,
+                                                       bool AllowStale = false);
   void RealizeTopLevelDeclsFromPreamble();
 
   /// \brief Transfers ownership of the objects (like SourceManager) from
@@ -524,6 +539,25 @@ public:
   /// \brief Add a new local file-level declaration.
   void addFileLevelDecl(Decl *D);
 
+  /// \brief Set whether an out-of-date precompiled preamble should continue
+  /// to be used, rather than rebuilt, when reparsing or performing code
+  /// completion.
+  ///
+  /// A preamble is out-of-date when one of the files it includes changed.
+  /// Using it anyway avoids blocking the reparse on precompiling the
+  /// preamble again, at the cost of results that reflect the previous
+  /// contents of those files. Clients can check \c isPreambleStale() and
+  /// call \c Reparse() with \c RebuildStalePreamble set when idle. Only
+  /// changes made through remapped files (e.g., unsaved files) are deferred:
+  /// when an included file changed on disk, or the preamble portion of the
+  /// main file itself changed, the preamble is always rebuilt, since its
+  /// source locations no longer match the files.
+  void setDeferPreambleRebuild(bool Defer) { DeferPreambleRebuild = Defer; }
+
+  /// \brief Determine whether the most recent parse or code completion used
+  /// an out-of-date precompiled preamble.
+  bool isPreambleStale() const { return PreambleIsStale; }
+
   /// \brief Get the decls that are contained in a file in the Offset/Length
   /// range. \p Length can be 0 to indicate a point at \p Offset instead of
   /// a range. 
@@ -791,8 +825,12 @@ public:
   ///
   /// \returns True if a failure occurred that causes the ASTUnit not to
   /// contain any translation-unit information, false otherwise.  
+  ///
+  /// \param RebuildStalePreamble When true, an out-of-date precompiled
+  /// preamble is rebuilt even if rebuilding preambles has been deferred.
   bool Reparse(RemappedFile *RemappedFiles = 0,
-               unsigned NumRemappedFiles = 0);
+               unsigned NumRemappedFiles = 0,
+               bool RebuildStalePreamble = false);
 
   /// \brief Perform code completion at the given file, line, and
   /// column within this translation unit.
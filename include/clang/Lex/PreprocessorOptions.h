@@ -71,6 +71,12 @@ public:
   /// \brief Dump declarations that are deserialized from PCH, for testing.
   bool DumpDeserializedPCHDecls;
 
+  /// \brief When true, the contents of memory buffers and overridden files
+  /// embedded into a precompiled header are stored compressed. They are
+  /// decompressed lazily, when the corresponding source location entry is
+  /// first loaded.
+  bool CompressPCHBuffers;
+
   /// \brief This is a set of names for decls that we do not want to be
   /// deserialized, and we emit an error if they are; for testing purposes.
   std::set<std::string> DeserializedPCHDeclsToErrorOn;
@@ -81,6 +87,12 @@ public:
   /// The boolean indicates whether the preamble ends at the start of a new
   /// line.
   std::pair<unsigned, bool> PrecompiledPreambleBytes;
+
+  /// \brief When true, the precompiled preamble is knowingly used although
+  /// some of the files it includes are now remapped. Those files are still
+  /// unchanged on disk, so the AST reader reads them from there without
+  /// complaining about the remapping.
+  bool StalePrecompiledPreamble;
   
   /// The implicit PTH input included at the start of the translation unit, or
   /// empty.
@@ -179,7 +191,9 @@ public:
                           DisablePCHValidation(false),
                           AllowPCHWithCompilerErrors(false),
                           DumpDeserializedPCHDecls(false),
+                          CompressPCHBuffers(false),
                           PrecompiledPreambleBytes(0, true),
+                          StalePrecompiledPreamble(false),
                           RemappedFilesKeepOriginalName(true),
                           RetainRemappedFileBuffers(false),
                           ObjCXXARCStandardLibrary(ARCXX_nolib) { }
@@ -6414,6 +6414,15 @@ public:
   /// but have not yet been performed.
   std::deque<PendingImplicitInstantiation> PendingInstantiations;
 
+  /// \brief The implicit template instantiations that were not performed
+  /// while building a PCH with -fpch-instantiate-templates, because their
+  /// templates are not defined yet.
+  ///
+  /// They are added back to \c PendingInstantiations at the end of the PCH,
+  /// so that the translation units that use it, which may define the
+  /// templates, perform them.
+  std::deque<PendingImplicitInstantiation> DeferredPCHInstantiations;
+
   /// \brief The queue of implicit template instantiations that are required
   /// and must be performed within the current local scope.
   ///
@@ -35,7 +35,7 @@ namespace clang {
     /// Version 4 of AST files also requires that the version control branch and
     /// revision match exactly, since there is no backward compatibility of
     /// AST files at this time.
-    const unsigned VERSION_MAJOR = 5;
+    const unsigned VERSION_MAJOR = 6;
 
     /// \brief AST file minor version number supported by this version of
     /// Clang.
@@ -556,7 +556,11 @@ namespace clang {
       SM_SLOC_BUFFER_BLOB = 3,
       /// \brief Describes a source location entry (SLocEntry) for a
       /// macro expansion.
-      SM_SLOC_EXPANSION_ENTRY = 4
+      SM_SLOC_EXPANSION_ENTRY = 4,
+      /// \brief Describes a zlib-compressed blob that contains the data for
+      /// a buffer entry, along with the size of the uncompressed data. This
+      /// kind of record may appear wherever a SM_SLOC_BUFFER_BLOB may.
+      SM_SLOC_BUFFER_BLOB_COMPRESSED = 5
     };
 
     /// \brief Record types used within a preprocessor block.
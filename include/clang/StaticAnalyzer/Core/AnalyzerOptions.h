@@ -116,6 +116,26 @@ enum IPAKind {
   IPAK_DynamicDispatchBifurcate = 5
 };
 
+/// \brief Describes the order in which the paths through a function are
+/// explored.
+enum ExplorationStrategyKind {
+  ESK_NotSet = 0,
+
+  /// Explore the paths depth-first.
+  ESK_DFS = 1,
+
+  /// Explore the paths breadth-first.
+  ESK_BFS = 2,
+
+  /// Explore the basic blocks breadth-first, and the contents of each basic
+  /// block depth-first.
+  ESK_BFSBlockDFSContents = 3,
+
+  /// Explore the paths depth-first, but first follow the paths that enter
+  /// basic blocks which have not been visited yet.
+  ESK_UnexploredFirst = 4
+};
+
 class AnalyzerOptions : public RefCountedBase<AnalyzerOptions> {
 public:
   typedef llvm::StringMap<std::string> ConfigTable;
@@ -186,6 +206,10 @@ private:
   /// Controls the mode of inter-procedural analysis.
   IPAKind IPAMode;
 
+  /// Controls the order in which the paths through a function are explored.
+  /// \sa getExplorationStrategy
+  ExplorationStrategyKind ExplorationStrategy;
+
   /// Controls which C++ member functions will be considered for inlining.
   CXXInlineableMemberKind CXXMemberInliningMode;
   
@@ -238,6 +262,18 @@ private:
   /// \sa getMaxNodesPerTopLevelFunction
   Optional<unsigned> MaxNodesPerTopLevelFunction;
 
+  /// \sa getMaxGraphMemory
+  Optional<unsigned> MaxGraphMemory;
+
+  /// \sa getMaxCachedDeclContexts
+  Optional<unsigned> MaxCachedDeclContexts;
+
+  /// \sa getShardCount
+  Optional<unsigned> ShardCount;
+
+  /// \sa getShardIndex
+  Optional<unsigned> ShardIndex;
+
 public:
   /// Interprets an option's string value as a boolean.
   ///
@@ -251,6 +287,10 @@ public:
   /// Interprets an option's string value as an integer value.
   int getOptionAsInteger(StringRef Name, int DefaultVal);
 
+  /// Returns an option's string value, or \p DefaultVal if it is not
+  /// provided.
+  StringRef getOptionAsString(StringRef Name, StringRef DefaultVal);
+
   /// \brief Retrieves and sets the UserMode. This is a high-level option,
   /// which is used to set other low-level options. It is not accessible
   /// outside of AnalyzerOptions.
@@ -259,6 +299,14 @@ public:
   /// \brief Returns the inter-procedural analysis mode.
   IPAKind getIPAMode();
 
+  /// \brief Returns the order in which the paths through a function are
+  /// explored.
+  ///
+  /// This is controlled by the 'exploration-strategy' config option, which
+  /// accepts the values "dfs" (the default), "bfs", "bfs-block-dfs-contents"
+  /// and "unexplored-first".
+  ExplorationStrategyKind getExplorationStrategy();
+
   /// Returns the option controlling which C++ member functions will be
   /// considered for inlining.
   ///
@@ -395,6 +443,44 @@ public:
   /// This is controlled by the 'max-nodes' config option.
   unsigned getMaxNodesPerTopLevelFunction();
 
+  /// Returns the maximum amount of memory, in megabytes, that the exploded
+  /// graph of a top level function may use. Exploration stops when it is
+  /// reached. 0 is the default, and means no limit.
+  ///
+  /// This is controlled by the 'max-graph-memory' config option.
+  unsigned getMaxGraphMemory();
+
+  /// Returns how many analysis contexts, with their CFGs and other analyses,
+  /// are kept from one top level function to the next. Keeping them avoids
+  /// rebuilding the CFGs of the functions inlined from many places.
+  ///
+  /// This is controlled by the 'max-cached-decl-contexts' config option.
+  unsigned getMaxCachedDeclContexts();
+
+  /// Returns the number of shards the analysis of the translation unit is
+  /// split into, so that it can be performed by several processes.
+  ///
+  /// Functions that are connected in the call graph are analyzed by the
+  /// same shard. Only the shard with index 0 runs the syntax-based checks.
+  ///
+  /// This is controlled by the 'shard-count' config option.
+  unsigned getShardCount();
+
+  /// Returns the index of the shard to analyze, from 0 to the number of
+  /// shards minus one. The frontend rejects indices out of that range.
+  ///
+  /// This is controlled by the 'shard-index' config option.
+  unsigned getShardIndex();
+
+  /// Returns the path of the file that records the top level functions that
+  /// were analyzed without producing any path-sensitive reports. When it is
+  /// not empty, the functions recorded in the file are not analyzed again
+  /// unless they, their callees or the analyzer configuration have changed,
+  /// and the file is rewritten at the end of the analysis.
+  ///
+  /// This is controlled by the 'analysis-cache-file' config option.
+  StringRef getAnalysisCacheFile();
+
 public:
   AnalyzerOptions() :
     AnalysisStoreOpt(RegionStoreModel),
@@ -417,6 +503,7 @@ public:
     InliningMode(NoRedundancy),
     UserMode(UMK_NotSet),
     IPAMode(IPAK_NotSet),
+    ExplorationStrategy(ESK_NotSet),
     CXXMemberInliningMode() {}
 
 };
@@ -54,8 +54,12 @@ public:
 
   ~AnalysisManager();
   
-  void ClearContexts() {
-    AnaCtxMgr.clear();
+  /// Discard the AnalysisDeclContexts that are not among the most recently
+  /// used ones, so that the CFGs of frequently inlined functions are not
+  /// rebuilt for every top level function. Returns the number of discarded
+  /// contexts.
+  unsigned ClearContexts() {
+    return AnaCtxMgr.clearLeastRecentlyUsed(options.getMaxCachedDeclContexts());
   }
   
   AnalysisDeclContextManager& getAnalysisDeclContextManager() {
@@ -25,6 +25,7 @@
 
 namespace clang {
 
+class AnalyzerOptions;
 class ProgramPointTag;
   
 namespace ento {
@@ -84,6 +85,12 @@ private:
   /// (This data is owned by AnalysisConsumer.)
   FunctionSummariesTy *FunctionSummaries;
 
+  /// The maximum number of bytes the simulation graph (including the states
+  /// it refers to) may allocate, or 0 if there is no limit.
+  size_t MaxGraphMemory;
+
+  bool isOverGraphMemoryBudget();
+
   void generateNode(const ProgramPoint &Loc,
                     ProgramStateRef State,
                     ExplodedNode *Pred);
@@ -109,11 +116,8 @@ private:
 public:
   /// Construct a CoreEngine object to analyze the provided CFG.
   CoreEngine(SubEngine& subengine,
-             FunctionSummariesTy *FS)
-    : SubEng(subengine), G(new ExplodedGraph()),
-      WList(WorkList::makeDFS()),
-      BCounterFactory(G->getAllocator()),
-      FunctionSummaries(FS){}
+             FunctionSummariesTy *FS,
+             AnalyzerOptions &Opts);
 
   /// getGraph - Returns the exploded graph.
   ExplodedGraph& getGraph() { return *G.get(); }
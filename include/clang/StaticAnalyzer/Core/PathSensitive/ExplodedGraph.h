@@ -382,6 +382,10 @@ public:
     ReclaimCounter = ReclaimNodeInterval = Interval;
   }
 
+  /// Returns how often nodes are reclaimed, or 0 if node reclamation is
+  /// disabled.
+  unsigned getNodeReclamationInterval() const { return ReclaimNodeInterval; }
+
   /// Reclaim "uninteresting" nodes created since the last time this method
   /// was called.
   void reclaimRecentlyAllocatedNodes();
@@ -102,6 +102,14 @@ public:
     Blocks.set(ID);
   }
 
+  bool isVisitedBasicBlock(unsigned ID, const Decl* D) {
+    MapTy::const_iterator I = Map.find(D);
+    if (I == Map.end())
+      return false;
+    const llvm::SmallBitVector &Blocks = I->second.VisitedBasicBlocks;
+    return ID < Blocks.size() && Blocks.test(ID);
+  }
+
   unsigned getNumVisitedBasicBlocks(const Decl* D) {
     MapTy::const_iterator I = Map.find(D);
     if (I != Map.end())
@@ -25,6 +25,8 @@ class CFGBlock;
 
 namespace ento {
 
+class FunctionSummariesTy;
+
 class WorkListUnit {
   ExplodedNode *node;
   BlockCounter counter;
@@ -91,6 +93,10 @@ public:
   static WorkList *makeDFS();
   static WorkList *makeBFS();
   static WorkList *makeBFSBlockDFSContents();
+
+  /// Returns a depth-first worklist that gives precedence to the units that
+  /// enter basic blocks not visited yet, according to \p FS.
+  static WorkList *makeUnexploredFirst(FunctionSummariesTy *FS);
 };
 
 } // end GR namespace
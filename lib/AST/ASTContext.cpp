@@ -54,11 +54,27 @@ unsigned ASTContext::NumImplicitMoveAssignmentOperators;
 unsigned ASTContext::NumImplicitMoveAssignmentOperatorsDeclared;
 unsigned ASTContext::NumImplicitDestructors;
 unsigned ASTContext::NumImplicitDestructorsDeclared;
+unsigned ASTContext::NumConstexprCallResults;
+unsigned ASTContext::NumConstexprCallResultsReused;
 
 enum FloatingRank {
   HalfRank, FloatRank, DoubleRank, LongDoubleRank
 };
 
+/// The number of times a uniqued type of each class was looked up, and the
+/// number of times the lookup found an existing type.
+static unsigned NumTypeLookups[Type::TypeLast + 1];
+static unsigned NumTypeLookupsReused[Type::TypeLast + 1];
+
+/// Record a lookup of a uniqued type of class \p TC which found \p Found.
+template <typename T>
+static T *noteTypeLookup(Type::TypeClass TC, T *Found) {
+  ++NumTypeLookups[TC];
+  if (Found)
+    ++NumTypeLookupsReused[TC];
+  return Found;
+}
+
 RawComment *ASTContext::getRawCommentForDeclNoCache(const Decl *D) const {
   if (!CommentsLoaded && ExternalSource) {
     ExternalSource->ReadComments();
@@ -732,6 +748,7 @@ ASTContext::ASTContext(LangOptions& LOpts, SourceManager &SM,
     NullTypeSourceInfo(QualType()), 
     FirstLocalImport(), LastLocalImport(),
     SourceMgr(SM), LangOpts(LOpts), 
+    StmtAllocatedMemory(0), TypeSourceInfoAllocatedMemory(0),
     AddrSpaceMap(0), Target(t), PrintingPolicy(LOpts),
     Idents(idents), Selectors(sels),
     BuiltinInfo(builtins),
@@ -787,6 +804,12 @@ ASTContext::~ASTContext() {
            E = MangleNumberingContexts.end();
        I != E; ++I)
     delete I->second;
+
+  for (llvm::FoldingSet<ConstexprCallResult>::iterator
+           I = ConstexprCallResults.begin(), E = ConstexprCallResults.end();
+       I != E; )
+    // Increment in loop to prevent using deallocated memory.
+    delete &*I++;
 }
 
 void ASTContext::AddDeallocation(void (*Callback)(void*), void *Data) {
@@ -820,6 +843,10 @@ void ASTContext::PrintStats() const {
   if (counts[Idx])                                                      \
     llvm::errs() << "    " << counts[Idx] << " " << #Name               \
                  << " types\n";                                         \
+  if (NumTypeLookups[Idx])                                              \
+    llvm::errs() << "      " << NumTypeLookupsReused[Idx] << "/"        \
+                 << NumTypeLookups[Idx] << " lookups found an "         \
+                 << "existing type\n";                                  \
   TotalBytes += counts[Idx] * sizeof(Name##Type);                       \
   ++Idx;
 #define ABSTRACT_TYPE(Name, Parent)
@@ -848,6 +875,21 @@ void ASTContext::PrintStats() const {
   llvm::errs() << NumImplicitDestructorsDeclared << "/"
                << NumImplicitDestructors
                << " implicit destructors created\n";
+  if (getLangOpts().CPlusPlus11)
+    llvm::errs() << NumConstexprCallResultsReused << "/"
+                 << NumConstexprCallResults
+                 << " constexpr call results reused\n";
+
+  llvm::errs() << "\n*** AST Context Memory:\n";
+  llvm::errs() << "  " << getASTAllocatedMemory()
+               << " bytes allocated for the AST\n";
+  llvm::errs() << "    " << TotalBytes << " bytes in types\n";
+  llvm::errs() << "    " << TypeSourceInfoAllocatedMemory
+               << " bytes in type source info\n";
+  llvm::errs() << "    " << StmtAllocatedMemory
+               << " bytes in statements and expressions\n";
+  llvm::errs() << "  " << getSideTableAllocatedMemory()
+               << " bytes allocated for side tables\n";
 
   if (ExternalSource.get()) {
     llvm::errs() << "\n";
@@ -1975,6 +2017,7 @@ TypeSourceInfo *ASTContext::CreateTypeSourceInfo(QualType T,
 
   TypeSourceInfo *TInfo =
     (TypeSourceInfo*)BumpAlloc.Allocate(sizeof(TypeSourceInfo) + DataSize, 8);
+  TypeSourceInfoAllocatedMemory += sizeof(TypeSourceInfo) + DataSize;
   new (TInfo) TypeSourceInfo(T);
   return TInfo;
 }
@@ -2122,7 +2165,8 @@ QualType ASTContext::getComplexType(QualType T) const {
   ComplexType::Profile(ID, T);
 
   void *InsertPos = 0;
-  if (ComplexType *CT = ComplexTypes.FindNodeOrInsertPos(ID, InsertPos))
+  if (ComplexType *CT = noteTypeLookup(
+          Type::Complex, ComplexTypes.FindNodeOrInsertPos(ID, InsertPos)))
     return QualType(CT, 0);
 
   // If the pointee type isn't canonical, this won't be a canonical type either,
@@ -2150,7 +2194,8 @@ QualType ASTContext::getPointerType(QualType T) const {
   PointerType::Profile(ID, T);
 
   void *InsertPos = 0;
-  if (PointerType *PT = PointerTypes.FindNodeOrInsertPos(ID, InsertPos))
+  if (PointerType *PT = noteTypeLookup(
+          Type::Pointer, PointerTypes.FindNodeOrInsertPos(ID, InsertPos)))
     return QualType(PT, 0);
 
   // If the pointee type isn't canonical, this won't be a canonical type either,
@@ -2175,7 +2220,8 @@ QualType ASTContext::getDecayedType(QualType T) const {
   llvm::FoldingSetNodeID ID;
   DecayedType::Profile(ID, T);
   void *InsertPos = 0;
-  if (DecayedType *DT = DecayedTypes.FindNodeOrInsertPos(ID, InsertPos))
+  if (DecayedType *DT = noteTypeLookup(
+          Type::Decayed, DecayedTypes.FindNodeOrInsertPos(ID, InsertPos)))
     return QualType(DT, 0);
 
   QualType Decayed;
@@ -2218,8 +2264,9 @@ QualType ASTContext::getBlockPointerType(QualType T) const {
   BlockPointerType::Profile(ID, T);
 
   void *InsertPos = 0;
-  if (BlockPointerType *PT =
-        BlockPointerTypes.FindNodeOrInsertPos(ID, InsertPos))
+  if (BlockPointerType *PT = noteTypeLookup(
+          Type::BlockPointer,
+          BlockPointerTypes.FindNodeOrInsertPos(ID, InsertPos)))
     return QualType(PT, 0);
 
   // If the block pointee type isn't canonical, this won't be a canonical
@@ -2253,8 +2300,9 @@ ASTContext::getLValueReferenceType(QualType T, bool SpelledAsLValue) const {
   ReferenceType::Profile(ID, T, SpelledAsLValue);
 
   void *InsertPos = 0;
-  if (LValueReferenceType *RT =
-        LValueReferenceTypes.FindNodeOrInsertPos(ID, InsertPos))
+  if (LValueReferenceType *RT = noteTypeLookup(
+          Type::LValueReference,
+          LValueReferenceTypes.FindNodeOrInsertPos(ID, InsertPos)))
     return QualType(RT, 0);
 
   const ReferenceType *InnerRef = T->getAs<ReferenceType>();
@@ -2290,8 +2338,9 @@ QualType ASTContext::getRValueReferenceType(QualType T) const {
   ReferenceType::Profile(ID, T, false);
 
   void *InsertPos = 0;
-  if (RValueReferenceType *RT =
-        RValueReferenceTypes.FindNodeOrInsertPos(ID, InsertPos))
+  if (RValueReferenceType *RT = noteTypeLookup(
+          Type::RValueReference,
+          RValueReferenceTypes.FindNodeOrInsertPos(ID, InsertPos)))
     return QualType(RT, 0);
 
   const ReferenceType *InnerRef = T->getAs<ReferenceType>();
@@ -2325,8 +2374,9 @@ QualType ASTContext::getMemberPointerType(QualType T, const Type *Cls) const {
   MemberPointerType::Profile(ID, T, Cls);
 
   void *InsertPos = 0;
-  if (MemberPointerType *PT =
-      MemberPointerTypes.FindNodeOrInsertPos(ID, InsertPos))
+  if (MemberPointerType *PT = noteTypeLookup(
+          Type::MemberPointer,
+          MemberPointerTypes.FindNodeOrInsertPos(ID, InsertPos)))
     return QualType(PT, 0);
 
   // If the pointee or class type isn't canonical, this won't be a canonical
@@ -2367,8 +2417,9 @@ QualType ASTContext::getConstantArrayType(QualType EltTy,
   ConstantArrayType::Profile(ID, EltTy, ArySize, ASM, IndexTypeQuals);
 
   void *InsertPos = 0;
-  if (ConstantArrayType *ATP =
-      ConstantArrayTypes.FindNodeOrInsertPos(ID, InsertPos))
+  if (ConstantArrayType *ATP = noteTypeLookup(
+          Type::ConstantArray,
+          ConstantArrayTypes.FindNodeOrInsertPos(ID, InsertPos)))
     return QualType(ATP, 0);
 
   // If the element type isn't canonical or has qualifiers, this won't
@@ -2591,7 +2642,8 @@ QualType ASTContext::getDependentSizedArrayType(QualType elementType,
 
   // Look for an existing type with these properties.
   DependentSizedArrayType *canonTy =
-    DependentSizedArrayTypes.FindNodeOrInsertPos(ID, insertPos);
+    noteTypeLookup(Type::DependentSizedArray,
+                   DependentSizedArrayTypes.FindNodeOrInsertPos(ID, insertPos));
 
   // If we don't have one, build one.
   if (!canonTy) {
@@ -2629,8 +2681,9 @@ QualType ASTContext::getIncompleteArrayType(QualType elementType,
   IncompleteArrayType::Profile(ID, elementType, ASM, elementTypeQuals);
 
   void *insertPos = 0;
-  if (IncompleteArrayType *iat =
-       IncompleteArrayTypes.FindNodeOrInsertPos(ID, insertPos))
+  if (IncompleteArrayType *iat = noteTypeLookup(
+          Type::IncompleteArray,
+          IncompleteArrayTypes.FindNodeOrInsertPos(ID, insertPos)))
     return QualType(iat, 0);
 
   // If the element type isn't canonical, this won't be a canonical type
@@ -2669,7 +2722,8 @@ QualType ASTContext::getVectorType(QualType vecType, unsigned NumElts,
   VectorType::Profile(ID, vecType, NumElts, Type::Vector, VecKind);
 
   void *InsertPos = 0;
-  if (VectorType *VTP = VectorTypes.FindNodeOrInsertPos(ID, InsertPos))
+  if (VectorType *VTP = noteTypeLookup(
+          Type::Vector, VectorTypes.FindNodeOrInsertPos(ID, InsertPos)))
     return QualType(VTP, 0);
 
   // If the element type isn't canonical, this won't be a canonical type either,
@@ -2700,7 +2754,8 @@ ASTContext::getExtVectorType(QualType vecType, unsigned NumElts) const {
   VectorType::Profile(ID, vecType, NumElts, Type::ExtVector,
                       VectorType::GenericVector);
   void *InsertPos = 0;
-  if (VectorType *VTP = VectorTypes.FindNodeOrInsertPos(ID, InsertPos))
+  if (VectorType *VTP = noteTypeLookup(
+          Type::ExtVector, VectorTypes.FindNodeOrInsertPos(ID, InsertPos)))
     return QualType(VTP, 0);
 
   // If the element type isn't canonical, this won't be a canonical type either,
@@ -2730,7 +2785,9 @@ ASTContext::getDependentSizedExtVectorType(QualType vecType,
 
   void *InsertPos = 0;
   DependentSizedExtVectorType *Canon
-    = DependentSizedExtVectorTypes.FindNodeOrInsertPos(ID, InsertPos);
+    = noteTypeLookup(Type::DependentSizedExtVector,
+                     DependentSizedExtVectorTypes.FindNodeOrInsertPos(
+                         ID, InsertPos));
   DependentSizedExtVectorType *New;
   if (Canon) {
     // We already have a canonical version of this array type; use it as
@@ -2775,8 +2832,9 @@ ASTContext::getFunctionNoProtoType(QualType ResultTy,
   FunctionNoProtoType::Profile(ID, ResultTy, Info);
 
   void *InsertPos = 0;
-  if (FunctionNoProtoType *FT =
-        FunctionNoProtoTypes.FindNodeOrInsertPos(ID, InsertPos))
+  if (FunctionNoProtoType *FT = noteTypeLookup(
+          Type::FunctionNoProto,
+          FunctionNoProtoTypes.FindNodeOrInsertPos(ID, InsertPos)))
     return QualType(FT, 0);
 
   QualType Canonical;
@@ -2818,8 +2876,9 @@ ASTContext::getFunctionType(QualType ResultTy, ArrayRef<QualType> ArgArray,
                              *this);
 
   void *InsertPos = 0;
-  if (FunctionProtoType *FTP =
-        FunctionProtoTypes.FindNodeOrInsertPos(ID, InsertPos))
+  if (FunctionProtoType *FTP = noteTypeLookup(
+          Type::FunctionProto,
+          FunctionProtoTypes.FindNodeOrInsertPos(ID, InsertPos)))
     return QualType(FTP, 0);
 
   // Determine whether the type being created is already canonical or not.
@@ -3002,7 +3061,8 @@ QualType ASTContext::getAttributedType(AttributedType::Kind attrKind,
   AttributedType::Profile(id, attrKind, modifiedType, equivalentType);
 
   void *insertPos = 0;
-  AttributedType *type = AttributedTypes.FindNodeOrInsertPos(id, insertPos);
+  AttributedType *type = noteTypeLookup(
+      Type::Attributed, AttributedTypes.FindNodeOrInsertPos(id, insertPos));
   if (type) return QualType(type, 0);
 
   QualType canon = getCanonicalType(equivalentType);
@@ -3027,7 +3087,9 @@ ASTContext::getSubstTemplateTypeParmType(const TemplateTypeParmType *Parm,
   SubstTemplateTypeParmType::Profile(ID, Parm, Replacement);
   void *InsertPos = 0;
   SubstTemplateTypeParmType *SubstParm
-    = SubstTemplateTypeParmTypes.FindNodeOrInsertPos(ID, InsertPos);
+    = noteTypeLookup(Type::SubstTemplateTypeParm,
+                     SubstTemplateTypeParmTypes.FindNodeOrInsertPos(ID,
+                                                                InsertPos));
 
   if (!SubstParm) {
     SubstParm = new (*this, TypeAlignment)
@@ -3056,7 +3118,9 @@ QualType ASTContext::getSubstTemplateTypeParmPackType(
   SubstTemplateTypeParmPackType::Profile(ID, Parm, ArgPack);
   void *InsertPos = 0;
   if (SubstTemplateTypeParmPackType *SubstParm
-        = SubstTemplateTypeParmPackTypes.FindNodeOrInsertPos(ID, InsertPos))
+        = noteTypeLookup(Type::SubstTemplateTypeParmPack,
+                         SubstTemplateTypeParmPackTypes.FindNodeOrInsertPos(
+                             ID, InsertPos)))
     return QualType(SubstParm, 0);
   
   QualType Canon;
@@ -3085,7 +3149,8 @@ QualType ASTContext::getTemplateTypeParmType(unsigned Depth, unsigned Index,
   TemplateTypeParmType::Profile(ID, Depth, Index, ParameterPack, TTPDecl);
   void *InsertPos = 0;
   TemplateTypeParmType *TypeParm
-    = TemplateTypeParmTypes.FindNodeOrInsertPos(ID, InsertPos);
+    = noteTypeLookup(Type::TemplateTypeParm,
+                     TemplateTypeParmTypes.FindNodeOrInsertPos(ID, InsertPos));
 
   if (TypeParm)
     return QualType(TypeParm, 0);
@@ -3226,7 +3291,9 @@ ASTContext::getCanonicalTemplateSpecializationType(TemplateName Template,
 
   void *InsertPos = 0;
   TemplateSpecializationType *Spec
-    = TemplateSpecializationTypes.FindNodeOrInsertPos(ID, InsertPos);
+    = noteTypeLookup(Type::TemplateSpecialization,
+                     TemplateSpecializationTypes.FindNodeOrInsertPos(ID,
+                                                                 InsertPos));
 
   if (!Spec) {
     // Allocate a new canonical template specialization type.
@@ -3253,7 +3320,8 @@ ASTContext::getElaboratedType(ElaboratedTypeKeyword Keyword,
   ElaboratedType::Profile(ID, Keyword, NNS, NamedType);
 
   void *InsertPos = 0;
-  ElaboratedType *T = ElaboratedTypes.FindNodeOrInsertPos(ID, InsertPos);
+  ElaboratedType *T = noteTypeLookup(
+      Type::Elaborated, ElaboratedTypes.FindNodeOrInsertPos(ID, InsertPos));
   if (T)
     return QualType(T, 0);
 
@@ -3277,7 +3345,8 @@ ASTContext::getParenType(QualType InnerType) const {
   ParenType::Profile(ID, InnerType);
 
   void *InsertPos = 0;
-  ParenType *T = ParenTypes.FindNodeOrInsertPos(ID, InsertPos);
+  ParenType *T = noteTypeLookup(Type::Paren,
+                                ParenTypes.FindNodeOrInsertPos(ID, InsertPos));
   if (T)
     return QualType(T, 0);
 
@@ -3316,7 +3385,8 @@ QualType ASTContext::getDependentNameType(ElaboratedTypeKeyword Keyword,
 
   void *InsertPos = 0;
   DependentNameType *T
-    = DependentNameTypes.FindNodeOrInsertPos(ID, InsertPos);
+    = noteTypeLookup(Type::DependentName,
+                     DependentNameTypes.FindNodeOrInsertPos(ID, InsertPos));
   if (T)
     return QualType(T, 0);
 
@@ -3357,7 +3427,9 @@ ASTContext::getDependentTemplateSpecializationType(
 
   void *InsertPos = 0;
   DependentTemplateSpecializationType *T
-    = DependentTemplateSpecializationTypes.FindNodeOrInsertPos(ID, InsertPos);
+    = noteTypeLookup(Type::DependentTemplateSpecialization,
+                     DependentTemplateSpecializationTypes.FindNodeOrInsertPos(
+                         ID, InsertPos));
   if (T)
     return QualType(T, 0);
 
@@ -3403,7 +3475,8 @@ QualType ASTContext::getPackExpansionType(QualType Pattern,
          "Pack expansions must expand one or more parameter packs");
   void *InsertPos = 0;
   PackExpansionType *T
-    = PackExpansionTypes.FindNodeOrInsertPos(ID, InsertPos);
+    = noteTypeLookup(Type::PackExpansion,
+                     PackExpansionTypes.FindNodeOrInsertPos(ID, InsertPos));
   if (T)
     return QualType(T, 0);
 
@@ -3477,7 +3550,8 @@ QualType ASTContext::getObjCObjectType(QualType BaseType,
   llvm::FoldingSetNodeID ID;
   ObjCObjectTypeImpl::Profile(ID, BaseType, Protocols, NumProtocols);
   void *InsertPos = 0;
-  if (ObjCObjectType *QT = ObjCObjectTypes.FindNodeOrInsertPos(ID, InsertPos))
+  if (ObjCObjectType *QT = noteTypeLookup(
+          Type::ObjCObject, ObjCObjectTypes.FindNodeOrInsertPos(ID, InsertPos)))
     return QualType(QT, 0);
 
   // Build the canonical type, which has the canonical base type and
@@ -3520,8 +3594,9 @@ QualType ASTContext::getObjCObjectPointerType(QualType ObjectT) const {
   ObjCObjectPointerType::Profile(ID, ObjectT);
 
   void *InsertPos = 0;
-  if (ObjCObjectPointerType *QT =
-              ObjCObjectPointerTypes.FindNodeOrInsertPos(ID, InsertPos))
+  if (ObjCObjectPointerType *QT = noteTypeLookup(
+          Type::ObjCObjectPointer,
+          ObjCObjectPointerTypes.FindNodeOrInsertPos(ID, InsertPos)))
     return QualType(QT, 0);
 
   // Find the canonical object type.
@@ -3580,7 +3655,9 @@ QualType ASTContext::getTypeOfExprType(Expr *tofExpr) const {
 
     void *InsertPos = 0;
     DependentTypeOfExprType *Canon
-      = DependentTypeOfExprTypes.FindNodeOrInsertPos(ID, InsertPos);
+      = noteTypeLookup(Type::TypeOfExpr,
+                       DependentTypeOfExprTypes.FindNodeOrInsertPos(ID,
+                                                                InsertPos));
     if (Canon) {
       // We already have a "canonical" version of an identical, dependent
       // typeof(expr) type. Use that as our canonical type.
@@ -3632,7 +3709,9 @@ QualType ASTContext::getDecltypeType(Expr *e, QualType UnderlyingType) const {
 
     void *InsertPos = 0;
     DependentDecltypeType *Canon
-      = DependentDecltypeTypes.FindNodeOrInsertPos(ID, InsertPos);
+      = noteTypeLookup(Type::Decltype,
+                       DependentDecltypeTypes.FindNodeOrInsertPos(ID,
+                                                                  InsertPos));
     if (Canon) {
       // We already have a "canonical" version of an equivalent, dependent
       // decltype type. Use that as our canonical type.
@@ -3679,7 +3758,8 @@ QualType ASTContext::getAutoType(QualType DeducedType, bool IsDecltypeAuto,
   void *InsertPos = 0;
   llvm::FoldingSetNodeID ID;
   AutoType::Profile(ID, DeducedType, IsDecltypeAuto, IsDependent);
-  if (AutoType *AT = AutoTypes.FindNodeOrInsertPos(ID, InsertPos))
+  if (AutoType *AT = noteTypeLookup(
+          Type::Auto, AutoTypes.FindNodeOrInsertPos(ID, InsertPos)))
     return QualType(AT, 0);
 
   AutoType *AT = new (*this, TypeAlignment) AutoType(DeducedType,
@@ -3700,7 +3780,8 @@ QualType ASTContext::getAtomicType(QualType T) const {
   AtomicType::Profile(ID, T);
 
   void *InsertPos = 0;
-  if (AtomicType *AT = AtomicTypes.FindNodeOrInsertPos(ID, InsertPos))
+  if (AtomicType *AT = noteTypeLookup(
+          Type::Atomic, AtomicTypes.FindNodeOrInsertPos(ID, InsertPos)))
     return QualType(AT, 0);
 
   // If the atomic value type isn't canonical, this won't be a canonical type
@@ -8114,6 +8195,27 @@ ASTContext::getMaterializedTemporaryValue(const MaterializeTemporaryExpr *E,
   return I == MaterializedTemporaryValues.end() ? 0 : &I->second;
 }
 
+const APValue *
+ASTContext::getConstexprCallResult(const llvm::FoldingSetNodeID &Call) {
+  void *InsertPos;
+  ConstexprCallResult *R = ConstexprCallResults.FindNodeOrInsertPos(Call,
+                                                                   InsertPos);
+  if (!R)
+    return 0;
+  ++NumConstexprCallResultsReused;
+  return &R->Value;
+}
+
+void ASTContext::setConstexprCallResult(const llvm::FoldingSetNodeID &Call,
+                                        const APValue &Value) {
+  void *InsertPos;
+  if (ConstexprCallResults.FindNodeOrInsertPos(Call, InsertPos))
+    return;
+  ConstexprCallResults.InsertNode(new ConstexprCallResult(Call, Value),
+                                  InsertPos);
+  ++NumConstexprCallResults;
+}
+
 bool ASTContext::AtomicUsesUnsupportedLibcall(const AtomicExpr *E) const {
   const llvm::Triple &T = getTargetInfo().getTriple();
   if (!T.isOSDarwin())
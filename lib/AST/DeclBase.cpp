@@ -1196,6 +1196,22 @@ StoredDeclsMap *DeclContext::buildLookup() {
 
   SmallVector<DeclContext *, 2> Contexts;
   collectAllContexts(Contexts);
+
+  // Size the table for all of the declarations up front, so that building
+  // the lookup for a context with many declarations does not rehash the
+  // table (and copy every overload list in it) over and over again.
+  unsigned NumDecls = 0;
+  for (unsigned I = 0, N = Contexts.size(); I != N; ++I)
+    NumDecls += std::distance(Contexts[I]->decls_begin(),
+                              Contexts[I]->decls_end());
+  if (NumDecls > 64) {
+    StoredDeclsMap *Map = LookupPtr.getPointer();
+    if (!Map)
+      Map = CreateStoredDeclsMap(getParentASTContext());
+    // Keep the load factor below the 3/4 at which the table grows.
+    Map->resize(NumDecls * 4 / 3 + 1);
+  }
+
   for (unsigned I = 0, N = Contexts.size(); I != N; ++I)
     buildLookupImpl<&DeclContext::decls_begin,
                     &DeclContext::decls_end>(Contexts[I]);
@@ -443,7 +443,7 @@ DeclRefExpr *DeclRefExpr::Create(const ASTContext &Context,
   else if (TemplateKWLoc.isValid())
     Size += ASTTemplateKWAndArgsInfo::sizeFor(0);
 
-  void *Mem = Context.Allocate(Size, llvm::alignOf<DeclRefExpr>());
+  void *Mem = Context.AllocateStmt(Size, llvm::alignOf<DeclRefExpr>());
   return new (Mem) DeclRefExpr(Context, QualifierLoc, TemplateKWLoc, D,
                                RefersToEnclosingLocal,
                                NameInfo, FoundD, TemplateArgs, T, VK);
@@ -462,7 +462,7 @@ DeclRefExpr *DeclRefExpr::CreateEmpty(const ASTContext &Context,
   if (HasTemplateKWAndArgsInfo)
     Size += ASTTemplateKWAndArgsInfo::sizeFor(NumTemplateArgs);
 
-  void *Mem = Context.Allocate(Size, llvm::alignOf<DeclRefExpr>());
+  void *Mem = Context.AllocateStmt(Size, llvm::alignOf<DeclRefExpr>());
   return new (Mem) DeclRefExpr(EmptyShell());
 }
 
@@ -680,7 +680,7 @@ void APNumericStorage::setIntValue(const ASTContext &C,
   unsigned NumWords = Val.getNumWords();
   const uint64_t* Words = Val.getRawData();
   if (NumWords > 1) {
-    pVal = new (C) uint64_t[NumWords];
+    pVal = C.AllocateStmtArray<uint64_t>(NumWords);
     std::copy(Words, Words + NumWords, pVal);
   } else if (NumWords == 1)
     VAL = Words[0];
@@ -812,9 +812,9 @@ StringLiteral *StringLiteral::Create(const ASTContext &C, StringRef Str,
                                      unsigned NumStrs) {
   // Allocate enough space for the StringLiteral plus an array of locations for
   // any concatenated string tokens.
-  void *Mem = C.Allocate(sizeof(StringLiteral)+
-                         sizeof(SourceLocation)*(NumStrs-1),
-                         llvm::alignOf<StringLiteral>());
+  void *Mem = C.AllocateStmt(sizeof(StringLiteral)+
+                             sizeof(SourceLocation)*(NumStrs-1),
+                             llvm::alignOf<StringLiteral>());
   StringLiteral *SL = new (Mem) StringLiteral(Ty);
 
   // OPTIMIZE: could allocate this appended to the StringLiteral.
@@ -830,9 +830,9 @@ StringLiteral *StringLiteral::Create(const ASTContext &C, StringRef Str,
 
 StringLiteral *StringLiteral::CreateEmpty(const ASTContext &C,
                                           unsigned NumStrs) {
-  void *Mem = C.Allocate(sizeof(StringLiteral)+
-                         sizeof(SourceLocation)*(NumStrs-1),
-                         llvm::alignOf<StringLiteral>());
+  void *Mem = C.AllocateStmt(sizeof(StringLiteral)+
+                             sizeof(SourceLocation)*(NumStrs-1),
+                             llvm::alignOf<StringLiteral>());
   StringLiteral *SL = new (Mem) StringLiteral(QualType());
   SL->CharByteWidth = 0;
   SL->Length = 0;
@@ -947,19 +947,19 @@ void StringLiteral::setString(const ASTContext &C, StringRef Str,
 
   switch(CharByteWidth) {
     case 1: {
-      char *AStrData = new (C) char[Length];
+      char *AStrData = C.AllocateStmtArray<char>(Length);
       std::memcpy(AStrData,Str.data(),Length*sizeof(*AStrData));
       StrData.asChar = AStrData;
       break;
     }
     case 2: {
-      uint16_t *AStrData = new (C) uint16_t[Length];
+      uint16_t *AStrData = C.AllocateStmtArray<uint16_t>(Length);
       std::memcpy(AStrData,Str.data(),Length*sizeof(*AStrData));
       StrData.asUInt16 = AStrData;
       break;
     }
     case 4: {
-      uint32_t *AStrData = new (C) uint32_t[Length];
+      uint32_t *AStrData = C.AllocateStmtArray<uint32_t>(Length);
       std::memcpy(AStrData,Str.data(),Length*sizeof(*AStrData));
       StrData.asUInt32 = AStrData;
       break;
@@ -1096,7 +1096,7 @@ CallExpr::CallExpr(const ASTContext& C, StmtClass SC, Expr *fn,
          fn->containsUnexpandedParameterPack()),
     NumArgs(args.size()) {
 
-  SubExprs = new (C) Stmt*[args.size()+PREARGS_START+NumPreArgs];
+  SubExprs = C.AllocateStmtArray<Stmt*>(args.size()+PREARGS_START+NumPreArgs);
   SubExprs[FN] = fn;
   for (unsigned i = 0; i != args.size(); ++i) {
     if (args[i]->isTypeDependent())
@@ -1124,7 +1124,7 @@ CallExpr::CallExpr(const ASTContext& C, Expr *fn, ArrayRef<Expr*> args,
          fn->containsUnexpandedParameterPack()),
     NumArgs(args.size()) {
 
-  SubExprs = new (C) Stmt*[args.size()+PREARGS_START];
+  SubExprs = C.AllocateStmtArray<Stmt*>(args.size()+PREARGS_START);
   SubExprs[FN] = fn;
   for (unsigned i = 0; i != args.size(); ++i) {
     if (args[i]->isTypeDependent())
@@ -1146,7 +1146,7 @@ CallExpr::CallExpr(const ASTContext& C, Expr *fn, ArrayRef<Expr*> args,
 CallExpr::CallExpr(const ASTContext &C, StmtClass SC, EmptyShell Empty)
   : Expr(SC, Empty), SubExprs(0), NumArgs(0) {
   // FIXME: Why do we allocate this?
-  SubExprs = new (C) Stmt*[PREARGS_START];
+  SubExprs = C.AllocateStmtArray<Stmt*>(PREARGS_START);
   CallExprBits.NumPreArgs = 0;
 }
 
@@ -1154,7 +1154,7 @@ CallExpr::CallExpr(const ASTContext &C, StmtClass SC, unsigned NumPreArgs,
                    EmptyShell Empty)
   : Expr(SC, Empty), SubExprs(0), NumArgs(0) {
   // FIXME: Why do we allocate this?
-  SubExprs = new (C) Stmt*[PREARGS_START+NumPreArgs];
+  SubExprs = C.AllocateStmtArray<Stmt*>(PREARGS_START+NumPreArgs);
   CallExprBits.NumPreArgs = NumPreArgs;
 }
 
@@ -1201,7 +1201,8 @@ void CallExpr::setNumArgs(const ASTContext& C, unsigned NumArgs) {
 
   // Otherwise, we are growing the # arguments.  New an bigger argument array.
   unsigned NumPreArgs = getNumPreArgs();
-  Stmt **NewSubExprs = new (C) Stmt*[NumArgs+PREARGS_START+NumPreArgs];
+  Stmt **NewSubExprs =
+    C.AllocateStmtArray<Stmt*>(NumArgs+PREARGS_START+NumPreArgs);
   // Copy over args.
   for (unsigned i = 0; i != getNumArgs()+PREARGS_START+NumPreArgs; ++i)
     NewSubExprs[i] = SubExprs[i];
@@ -1284,9 +1285,9 @@ OffsetOfExpr *OffsetOfExpr::Create(const ASTContext &C, QualType type,
                                    ArrayRef<OffsetOfNode> comps,
                                    ArrayRef<Expr*> exprs,
                                    SourceLocation RParenLoc) {
-  void *Mem = C.Allocate(sizeof(OffsetOfExpr) +
-                         sizeof(OffsetOfNode) * comps.size() +
-                         sizeof(Expr*) * exprs.size());
+  void *Mem = C.AllocateStmt(sizeof(OffsetOfExpr) +
+                             sizeof(OffsetOfNode) * comps.size() +
+                             sizeof(Expr*) * exprs.size());
 
   return new (Mem) OffsetOfExpr(C, type, OperatorLoc, tsi, comps, exprs,
                                 RParenLoc);
@@ -1294,9 +1295,9 @@ OffsetOfExpr *OffsetOfExpr::Create(const ASTContext &C, QualType type,
 
 OffsetOfExpr *OffsetOfExpr::CreateEmpty(const ASTContext &C,
                                         unsigned numComps, unsigned numExprs) {
-  void *Mem = C.Allocate(sizeof(OffsetOfExpr) +
-                         sizeof(OffsetOfNode) * numComps +
-                         sizeof(Expr*) * numExprs);
+  void *Mem = C.AllocateStmt(sizeof(OffsetOfExpr) +
+                             sizeof(OffsetOfNode) * numComps +
+                             sizeof(Expr*) * numExprs);
   return new (Mem) OffsetOfExpr(numComps, numExprs);
 }
 
@@ -1357,7 +1358,7 @@ MemberExpr *MemberExpr::Create(const ASTContext &C, Expr *base, bool isarrow,
   else if (TemplateKWLoc.isValid())
     Size += ASTTemplateKWAndArgsInfo::sizeFor(0);
 
-  void *Mem = C.Allocate(Size, llvm::alignOf<MemberExpr>());
+  void *Mem = C.AllocateStmt(Size, llvm::alignOf<MemberExpr>());
   MemberExpr *E = new (Mem) MemberExpr(base, isarrow, memberdecl, nameinfo,
                                        ty, vk, ok);
 
@@ -1701,7 +1702,8 @@ ImplicitCastExpr *ImplicitCastExpr::Create(const ASTContext &C, QualType T,
                                            ExprValueKind VK) {
   unsigned PathSize = (BasePath ? BasePath->size() : 0);
   void *Buffer =
-    C.Allocate(sizeof(ImplicitCastExpr) + PathSize * sizeof(CXXBaseSpecifier*));
+    C.AllocateStmt(sizeof(ImplicitCastExpr) +
+                   PathSize * sizeof(CXXBaseSpecifier*));
   ImplicitCastExpr *E =
     new (Buffer) ImplicitCastExpr(T, Kind, Operand, PathSize, VK);
   if (PathSize) E->setCastPath(*BasePath);
@@ -1711,7 +1713,8 @@ ImplicitCastExpr *ImplicitCastExpr::Create(const ASTContext &C, QualType T,
 ImplicitCastExpr *ImplicitCastExpr::CreateEmpty(const ASTContext &C,
                                                 unsigned PathSize) {
   void *Buffer =
-    C.Allocate(sizeof(ImplicitCastExpr) + PathSize * sizeof(CXXBaseSpecifier*));
+    C.AllocateStmt(sizeof(ImplicitCastExpr) +
+                   PathSize * sizeof(CXXBaseSpecifier*));
   return new (Buffer) ImplicitCastExpr(EmptyShell(), PathSize);
 }
 
@@ -1723,7 +1726,8 @@ CStyleCastExpr *CStyleCastExpr::Create(const ASTContext &C, QualType T,
                                        SourceLocation L, SourceLocation R) {
   unsigned PathSize = (BasePath ? BasePath->size() : 0);
   void *Buffer =
-    C.Allocate(sizeof(CStyleCastExpr) + PathSize * sizeof(CXXBaseSpecifier*));
+    C.AllocateStmt(sizeof(CStyleCastExpr) +
+                   PathSize * sizeof(CXXBaseSpecifier*));
   CStyleCastExpr *E =
     new (Buffer) CStyleCastExpr(T, VK, K, Op, PathSize, WrittenTy, L, R);
   if (PathSize) E->setCastPath(*BasePath);
@@ -1733,7 +1737,8 @@ CStyleCastExpr *CStyleCastExpr::Create(const ASTContext &C, QualType T,
 CStyleCastExpr *CStyleCastExpr::CreateEmpty(const ASTContext &C,
                                             unsigned PathSize) {
   void *Buffer =
-    C.Allocate(sizeof(CStyleCastExpr) + PathSize * sizeof(CXXBaseSpecifier*));
+    C.AllocateStmt(sizeof(CStyleCastExpr) +
+                   PathSize * sizeof(CXXBaseSpecifier*));
   return new (Buffer) CStyleCastExpr(EmptyShell(), PathSize);
 }
 
@@ -1860,20 +1865,33 @@ InitListExpr::InitListExpr(const ASTContext &C, SourceLocation lbraceloc,
   }
       
   InitExprs.insert(C, InitExprs.end(), initExprs.begin(), initExprs.end());
+  noteInitExprsGrowth(C, 0);
+}
+
+void InitListExpr::noteInitExprsGrowth(const ASTContext &C,
+                                       size_t OldCapacity) {
+  if (InitExprs.capacity() != OldCapacity)
+    C.StmtAllocatedMemory += InitExprs.capacity() * sizeof(Stmt *);
 }
 
 void InitListExpr::reserveInits(const ASTContext &C, unsigned NumInits) {
+  size_t OldCapacity = InitExprs.capacity();
   if (NumInits > InitExprs.size())
     InitExprs.reserve(C, NumInits);
+  noteInitExprsGrowth(C, OldCapacity);
 }
 
 void InitListExpr::resizeInits(const ASTContext &C, unsigned NumInits) {
+  size_t OldCapacity = InitExprs.capacity();
   InitExprs.resize(C, NumInits, 0);
+  noteInitExprsGrowth(C, OldCapacity);
 }
 
 Expr *InitListExpr::updateInit(const ASTContext &C, unsigned Init, Expr *expr) {
   if (Init >= InitExprs.size()) {
+    size_t OldCapacity = InitExprs.capacity();
     InitExprs.insert(C, InitExprs.end(), Init - InitExprs.size() + 1, 0);
+    noteInitExprsGrowth(C, OldCapacity);
     InitExprs.back() = expr;
     return 0;
   }
@@ -3522,7 +3540,7 @@ ObjCMessageExpr *ObjCMessageExpr::alloc(const ASTContext &C,
                                         unsigned NumStoredSelLocs) {
   unsigned Size = sizeof(ObjCMessageExpr) + sizeof(void *) + 
     NumArgs * sizeof(Expr *) + NumStoredSelLocs * sizeof(SourceLocation);
-  return (ObjCMessageExpr *)C.Allocate(Size,
+  return (ObjCMessageExpr *)C.AllocateStmt(Size,
                                      llvm::AlignOf<ObjCMessageExpr>::Alignment);
 }
 
@@ -3603,7 +3621,7 @@ ShuffleVectorExpr::ShuffleVectorExpr(const ASTContext &C, ArrayRef<Expr*> args,
           Type->containsUnexpandedParameterPack()),
      BuiltinLoc(BLoc), RParenLoc(RP), NumExprs(args.size())
 {
-  SubExprs = new (C) Stmt*[args.size()];
+  SubExprs = C.AllocateStmtArray<Stmt*>(args.size());
   for (unsigned i = 0; i != args.size(); i++) {
     if (args[i]->isTypeDependent())
       ExprBits.TypeDependent = true;
@@ -3622,7 +3640,7 @@ void ShuffleVectorExpr::setExprs(const ASTContext &C, ArrayRef<Expr *> Exprs) {
   if (SubExprs) C.Deallocate(SubExprs);
 
   this->NumExprs = Exprs.size();
-  SubExprs = new (C) Stmt*[NumExprs];
+  SubExprs = C.AllocateStmtArray<Stmt*>(NumExprs);
   memcpy(SubExprs, Exprs.data(), sizeof(Expr *) * Exprs.size());
 }
 
@@ -3642,8 +3660,8 @@ GenericSelectionExpr::GenericSelectionExpr(const ASTContext &Context,
          AssocExprs[ResultIndex]->isValueDependent(),
          AssocExprs[ResultIndex]->isInstantiationDependent(),
          ContainsUnexpandedParameterPack),
-    AssocTypes(new (Context) TypeSourceInfo*[AssocTypes.size()]),
-    SubExprs(new (Context) Stmt*[END_EXPR+AssocExprs.size()]),
+    AssocTypes(Context.AllocateStmtArray<TypeSourceInfo*>(AssocTypes.size())),
+    SubExprs(Context.AllocateStmtArray<Stmt*>(END_EXPR+AssocExprs.size())),
     NumAssocs(AssocExprs.size()), ResultIndex(ResultIndex),
     GenericLoc(GenericLoc), DefaultLoc(DefaultLoc), RParenLoc(RParenLoc) {
   SubExprs[CONTROLLING] = ControllingExpr;
@@ -3667,8 +3685,8 @@ GenericSelectionExpr::GenericSelectionExpr(const ASTContext &Context,
          /*isValueDependent=*/true,
          /*isInstantiationDependent=*/true,
          ContainsUnexpandedParameterPack),
-    AssocTypes(new (Context) TypeSourceInfo*[AssocTypes.size()]),
-    SubExprs(new (Context) Stmt*[END_EXPR+AssocExprs.size()]),
+    AssocTypes(Context.AllocateStmtArray<TypeSourceInfo*>(AssocTypes.size())),
+    SubExprs(Context.AllocateStmtArray<Stmt*>(END_EXPR+AssocExprs.size())),
     NumAssocs(AssocExprs.size()), ResultIndex(-1U), GenericLoc(GenericLoc),
     DefaultLoc(DefaultLoc), RParenLoc(RParenLoc) {
   SubExprs[CONTROLLING] = ControllingExpr;
@@ -3703,7 +3721,7 @@ DesignatedInitExpr::DesignatedInitExpr(const ASTContext &C, QualType Ty,
          Init->containsUnexpandedParameterPack()),
     EqualOrColonLoc(EqualOrColonLoc), GNUSyntax(GNUSyntax),
     NumDesignators(NumDesignators), NumSubExprs(IndexExprs.size() + 1) {
-  this->Designators = new (C) Designator[NumDesignators];
+  this->Designators = C.AllocateStmtArray<Designator>(NumDesignators);
 
   // Record the initializer itself.
   child_range Child = children();
@@ -3761,8 +3779,8 @@ DesignatedInitExpr::Create(const ASTContext &C, Designator *Designators,
                            ArrayRef<Expr*> IndexExprs,
                            SourceLocation ColonOrEqualLoc,
                            bool UsesColonSyntax, Expr *Init) {
-  void *Mem = C.Allocate(sizeof(DesignatedInitExpr) +
-                         sizeof(Stmt *) * (IndexExprs.size() + 1), 8);
+  void *Mem = C.AllocateStmt(sizeof(DesignatedInitExpr) +
+                             sizeof(Stmt *) * (IndexExprs.size() + 1), 8);
   return new (Mem) DesignatedInitExpr(C, C.VoidTy, NumDesignators, Designators,
                                       ColonOrEqualLoc, UsesColonSyntax,
                                       IndexExprs, Init);
@@ -3770,15 +3788,15 @@ DesignatedInitExpr::Create(const ASTContext &C, Designator *Designators,
 
 DesignatedInitExpr *DesignatedInitExpr::CreateEmpty(const ASTContext &C,
                                                     unsigned NumIndexExprs) {
-  void *Mem = C.Allocate(sizeof(DesignatedInitExpr) +
-                         sizeof(Stmt *) * (NumIndexExprs + 1), 8);
+  void *Mem = C.AllocateStmt(sizeof(DesignatedInitExpr) +
+                             sizeof(Stmt *) * (NumIndexExprs + 1), 8);
   return new (Mem) DesignatedInitExpr(NumIndexExprs + 1);
 }
 
 void DesignatedInitExpr::setDesignators(const ASTContext &C,
                                         const Designator *Desigs,
                                         unsigned NumDesigs) {
-  Designators = new (C) Designator[NumDesigs];
+  Designators = C.AllocateStmtArray<Designator>(NumDesigs);
   NumDesignators = NumDesigs;
   for (unsigned I = 0; I != NumDesigs; ++I)
     Designators[I] = Desigs[I];
@@ -3858,7 +3876,7 @@ void DesignatedInitExpr::ExpandDesignator(const ASTContext &C, unsigned Idx,
   }
 
   Designator *NewDesignators
-    = new (C) Designator[NumDesignators - 1 + NumNewDesignators];
+    = C.AllocateStmtArray<Designator>(NumDesignators - 1 + NumNewDesignators);
   std::copy(Designators, Designators + Idx, NewDesignators);
   std::copy(First, Last, NewDesignators + Idx);
   std::copy(Designators + Idx + 1, Designators + NumDesignators,
@@ -3873,7 +3891,7 @@ ParenListExpr::ParenListExpr(const ASTContext& C, SourceLocation lparenloc,
   : Expr(ParenListExprClass, QualType(), VK_RValue, OK_Ordinary,
          false, false, false, false),
     NumExprs(exprs.size()), LParenLoc(lparenloc), RParenLoc(rparenloc) {
-  Exprs = new (C) Stmt*[exprs.size()];
+  Exprs = C.AllocateStmtArray<Stmt*>(exprs.size());
   for (unsigned i = 0; i != exprs.size(); ++i) {
     if (exprs[i]->isTypeDependent())
       ExprBits.TypeDependent = true;
@@ -3902,9 +3920,9 @@ const OpaqueValueExpr *OpaqueValueExpr::findInCopyConstruct(const Expr *e) {
 PseudoObjectExpr *PseudoObjectExpr::Create(const ASTContext &Context,
                                            EmptyShell sh,
                                            unsigned numSemanticExprs) {
-  void *buffer = Context.Allocate(sizeof(PseudoObjectExpr) +
+  void *buffer = Context.AllocateStmt(sizeof(PseudoObjectExpr) +
                                     (1 + numSemanticExprs) * sizeof(Expr*),
-                                  llvm::alignOf<PseudoObjectExpr>());
+                                      llvm::alignOf<PseudoObjectExpr>());
   return new(buffer) PseudoObjectExpr(sh, numSemanticExprs);
 }
 
@@ -3931,9 +3949,9 @@ PseudoObjectExpr *PseudoObjectExpr::Create(const ASTContext &C, Expr *syntax,
     assert(semantics[resultIndex]->getObjectKind() == OK_Ordinary);
   }
 
-  void *buffer = C.Allocate(sizeof(PseudoObjectExpr) +
+  void *buffer = C.AllocateStmt(sizeof(PseudoObjectExpr) +
                               (1 + semantics.size()) * sizeof(Expr*),
-                            llvm::alignOf<PseudoObjectExpr>());
+                                llvm::alignOf<PseudoObjectExpr>());
   return new(buffer) PseudoObjectExpr(type, VK, syntax, semantics,
                                       resultIndex);
 }
@@ -4032,16 +4050,16 @@ ObjCArrayLiteral *ObjCArrayLiteral::Create(const ASTContext &C,
                                            ArrayRef<Expr *> Elements,
                                            QualType T, ObjCMethodDecl * Method,
                                            SourceRange SR) {
-  void *Mem = C.Allocate(sizeof(ObjCArrayLiteral) 
-                         + Elements.size() * sizeof(Expr *));
+  void *Mem = C.AllocateStmt(sizeof(ObjCArrayLiteral) 
+                             + Elements.size() * sizeof(Expr *));
   return new (Mem) ObjCArrayLiteral(Elements, T, Method, SR);
 }
 
 ObjCArrayLiteral *ObjCArrayLiteral::CreateEmpty(const ASTContext &C,
                                                 unsigned NumElements) {
   
-  void *Mem = C.Allocate(sizeof(ObjCArrayLiteral) 
-                         + NumElements * sizeof(Expr *));
+  void *Mem = C.AllocateStmt(sizeof(ObjCArrayLiteral) 
+                             + NumElements * sizeof(Expr *));
   return new (Mem) ObjCArrayLiteral(EmptyShell(), NumElements);
 }
 
@@ -4091,8 +4109,8 @@ ObjCDictionaryLiteral::Create(const ASTContext &C,
   if (HasPackExpansions)
     ExpansionsSize = sizeof(ExpansionData) * VK.size();
     
-  void *Mem = C.Allocate(sizeof(ObjCDictionaryLiteral) + 
-                         sizeof(KeyValuePair) * VK.size() + ExpansionsSize);
+  void *Mem = C.AllocateStmt(sizeof(ObjCDictionaryLiteral) + 
+                             sizeof(KeyValuePair) * VK.size() + ExpansionsSize);
   return new (Mem) ObjCDictionaryLiteral(VK, HasPackExpansions, T, method, SR);
 }
 
@@ -4102,8 +4120,9 @@ ObjCDictionaryLiteral::CreateEmpty(const ASTContext &C, unsigned NumElements,
   unsigned ExpansionsSize = 0;
   if (HasPackExpansions)
     ExpansionsSize = sizeof(ExpansionData) * NumElements;
-  void *Mem = C.Allocate(sizeof(ObjCDictionaryLiteral) + 
-                         sizeof(KeyValuePair) * NumElements + ExpansionsSize);
+  void *Mem = C.AllocateStmt(sizeof(ObjCDictionaryLiteral) + 
+                             sizeof(KeyValuePair) * NumElements +
+                             ExpansionsSize);
   return new (Mem) ObjCDictionaryLiteral(EmptyShell(), NumElements, 
                                          HasPackExpansions);
 }
@@ -4114,7 +4133,7 @@ ObjCSubscriptRefExpr *ObjCSubscriptRefExpr::Create(const ASTContext &C,
                                                    ObjCMethodDecl *getMethod,
                                                    ObjCMethodDecl *setMethod, 
                                                    SourceLocation RB) {
-  void *Mem = C.Allocate(sizeof(ObjCSubscriptRefExpr));
+  void *Mem = C.AllocateStmt(sizeof(ObjCSubscriptRefExpr));
   return new (Mem) ObjCSubscriptRefExpr(base, key, T, VK_LValue, 
                                         OK_ObjCSubscript,
                                         getMethod, setMethod, RB);
@@ -44,6 +44,7 @@
 #include "clang/Basic/Builtins.h"
 #include "clang/Basic/TargetInfo.h"
 #include "llvm/ADT/SmallString.h"
+#include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/raw_ostream.h"
 #include <cstring>
 #include <functional>
@@ -452,6 +453,11 @@ namespace {
     /// notes attached to it will also be stored, otherwise they will not be.
     bool HasActiveDiagnostic;
 
+    /// CheckingMemoizedCall - Are we re-evaluating the body of a memoized
+    /// call to check its result? Calls nested within it use the memoized
+    /// results, so that checking does not make the evaluation exponential.
+    bool CheckingMemoizedCall;
+
     enum EvaluationMode {
       /// Evaluate as a constant expression. Stop if we find that the expression
       /// is not a constant expression.
@@ -494,7 +500,8 @@ namespace {
         StepsLeft(getLangOpts().ConstexprStepLimit),
         BottomFrame(*this, SourceLocation(), 0, 0, 0),
         EvaluatingDecl((const ValueDecl*)0), EvaluatingDeclValue(0),
-        HasActiveDiagnostic(false), EvalMode(Mode) {}
+        HasActiveDiagnostic(false), CheckingMemoizedCall(false),
+        EvalMode(Mode) {}
 
     void setEvaluatingDecl(APValue::LValueBase Base, APValue &Value) {
       EvaluatingDecl = Base;
@@ -3557,6 +3564,95 @@ static bool EvaluateArgs(ArrayRef<const Expr*> Args, ArgVector &ArgValues,
   return Success;
 }
 
+/// Profile a call to a constexpr function whose result depends only on the
+/// callee and the argument values, because there is no 'this' and all of the
+/// arguments are integers or floating-point values. Returns false if the call
+/// is not of that form.
+static bool profileMemoizableCall(const FunctionDecl *Callee,
+                                  const LValue *This,
+                                  ArrayRef<APValue> Args,
+                                  llvm::FoldingSetNodeID &ID) {
+  if (This)
+    return false;
+
+  ID.AddPointer(Callee);
+  for (unsigned I = 0, N = Args.size(); I != N; ++I) {
+    const APValue &Arg = Args[I];
+    ID.AddInteger(Arg.getKind());
+    switch (Arg.getKind()) {
+    case APValue::Int:
+      ID.AddBoolean(Arg.getInt().isSigned());
+      Arg.getInt().Profile(ID);
+      break;
+    case APValue::Float:
+      Arg.getFloat().Profile(ID);
+      break;
+    default:
+      return false;
+    }
+  }
+  return true;
+}
+
+/// Whether the evaluation so far has produced a constant expression, so that
+/// the result of a call evaluated from here can be memoized.
+static bool isEvaluatingConstantExpression(EvalInfo &Info) {
+  switch (Info.EvalMode) {
+  case EvalInfo::EM_ConstantExpression:
+  case EvalInfo::EM_ConstantFold:
+  case EvalInfo::EM_IgnoreSideEffects:
+    // Any reason why the expression is not a constant expression is noted.
+    return Info.EvalStatus.Diag && Info.EvalStatus.Diag->empty() &&
+           !Info.EvalStatus.HasSideEffects;
+  case EvalInfo::EM_PotentialConstantExpression:
+  case EvalInfo::EM_EvaluateForOverflow:
+    return false;
+  }
+  llvm_unreachable("Missed EvalMode case");
+}
+
+/// Check that the result of re-evaluating a memoized call is identical to the
+/// memoized result.
+static bool isSameMemoizedResult(const APValue &Memoized,
+                                 const APValue &Result) {
+  if (Memoized.getKind() != Result.getKind())
+    return false;
+  if (Memoized.isInt())
+    return Memoized.getInt().getBitWidth() == Result.getInt().getBitWidth() &&
+           Memoized.getInt().isSigned() == Result.getInt().isSigned() &&
+           Memoized.getInt() == Result.getInt();
+  return Memoized.isFloat() &&
+         Memoized.getFloat().bitwiseIsEqual(Result.getFloat());
+}
+
+/// With -fconstexpr-check-memoization, evaluate the body of a call whose
+/// result was memoized again, and check that it produces the same result.
+/// The calls nested within it use their memoized results. The evaluation is
+/// speculative: it emits no diagnostics and uses up no evaluation steps, and
+/// if it fails (for instance, because it exceeds the depth limit) there is
+/// nothing to compare.
+static void checkMemoizedCall(SourceLocation CallLoc,
+                              const FunctionDecl *Callee,
+                              ArgVector &ArgValues, const Stmt *Body,
+                              EvalInfo &Info, const APValue &Memoized) {
+  SpeculativeEvaluationRAII Speculate(Info);
+  unsigned OldStepsLeft = Info.StepsLeft;
+  Info.CheckingMemoizedCall = true;
+
+  APValue Result;
+  EvalStmtResult ESR = ESR_Failed;
+  if (Info.CheckCallLimit(CallLoc)) {
+    CallStackFrame Frame(Info, CallLoc, Callee, /*This*/0, ArgValues.data());
+    ESR = EvaluateStmt(Result, Info, Body);
+  }
+
+  Info.CheckingMemoizedCall = false;
+  Info.StepsLeft = OldStepsLeft;
+  if (ESR == ESR_Returned && !isSameMemoizedResult(Memoized, Result))
+    Info.Ctx.getDiagnostics().Report(
+        CallLoc, diag::err_constexpr_memoized_result_mismatch) << Callee;
+}
+
 /// Evaluate a function call.
 static bool HandleFunctionCall(SourceLocation CallLoc,
                                const FunctionDecl *Callee, const LValue *This,
@@ -3566,6 +3662,23 @@ static bool HandleFunctionCall(SourceLocation CallLoc,
   if (!EvaluateArgs(Args, ArgValues, Info))
     return false;
 
+  // Calls which cannot depend on anything but the argument values are
+  // memoized, so that recursive and table-generating constexpr functions do
+  // not evaluate the same calls over and over again.
+  llvm::FoldingSetNodeID CallID;
+  bool Memoizable = !Info.checkingPotentialConstantExpression() &&
+                    profileMemoizableCall(Callee, This, ArgValues, CallID);
+  if (Memoizable) {
+    if (const APValue *Memoized = Info.Ctx.getConstexprCallResult(CallID)) {
+      if (Info.getLangOpts().CheckConstexprMemoization &&
+          !Info.CheckingMemoizedCall)
+        checkMemoizedCall(CallLoc, Callee, ArgValues, Body, Info, *Memoized);
+      Result = *Memoized;
+      return true;
+    }
+    Memoizable = isEvaluatingConstantExpression(Info);
+  }
+
   if (!Info.CheckCallLimit(CallLoc))
     return false;
 
@@ -3597,6 +3710,10 @@ static bool HandleFunctionCall(SourceLocation CallLoc,
       return true;
     Info.Diag(Callee->getLocEnd(), diag::note_constexpr_no_return);
   }
+  if (ESR == ESR_Returned && Memoizable &&
+      (Result.isInt() || Result.isFloat()) &&
+      isEvaluatingConstantExpression(Info))
+    Info.Ctx.setConstexprCallResult(CallID, Result);
   return ESR == ESR_Returned;
 }
 
@@ -52,7 +52,7 @@ static StmtClassNameTable &getStmtInfoTableEntry(Stmt::StmtClass E) {
 
 void *Stmt::operator new(size_t bytes, const ASTContext& C,
                          unsigned alignment) {
-  return ::operator new(bytes, C, alignment);
+  return C.AllocateStmt(bytes, alignment);
 }
 
 const char *Stmt::getStmtClassName() const {
@@ -265,7 +265,7 @@ CompoundStmt::CompoundStmt(const ASTContext &C, ArrayRef<Stmt*> Stmts,
     return;
   }
 
-  Body = new (C) Stmt*[Stmts.size()];
+  Body = C.AllocateStmtArray<Stmt*>(Stmts.size());
   std::copy(Stmts.begin(), Stmts.end(), Body);
 }
 
@@ -275,7 +275,7 @@ void CompoundStmt::setStmts(const ASTContext &C, Stmt **Stmts,
     C.Deallocate(Body);
   this->CompoundStmtBits.NumStmts = NumStmts;
 
-  Body = new (C) Stmt*[NumStmts];
+  Body = C.AllocateStmtArray<Stmt*>(NumStmts);
   memcpy(Body, Stmts, sizeof(Stmt *) * NumStmts);
 }
 
@@ -286,18 +286,18 @@ const char *LabelStmt::getName() const {
 AttributedStmt *AttributedStmt::Create(const ASTContext &C, SourceLocation Loc,
                                        ArrayRef<const Attr*> Attrs,
                                        Stmt *SubStmt) {
-  void *Mem = C.Allocate(sizeof(AttributedStmt) +
-                         sizeof(Attr*) * (Attrs.size() - 1),
-                         llvm::alignOf<AttributedStmt>());
+  void *Mem = C.AllocateStmt(sizeof(AttributedStmt) +
+                             sizeof(Attr*) * (Attrs.size() - 1),
+                             llvm::alignOf<AttributedStmt>());
   return new (Mem) AttributedStmt(Loc, Attrs, SubStmt);
 }
 
 AttributedStmt *AttributedStmt::CreateEmpty(const ASTContext &C,
                                             unsigned NumAttrs) {
   assert(NumAttrs > 0 && "NumAttrs should be greater than zero");
-  void *Mem = C.Allocate(sizeof(AttributedStmt) +
-                         sizeof(Attr*) * (NumAttrs - 1),
-                         llvm::alignOf<AttributedStmt>());
+  void *Mem = C.AllocateStmt(sizeof(AttributedStmt) +
+                             sizeof(Attr*) * (NumAttrs - 1),
+                             llvm::alignOf<AttributedStmt>());
   return new (Mem) AttributedStmt(EmptyShell(), NumAttrs);
 }
 
@@ -402,19 +402,19 @@ void GCCAsmStmt::setOutputsAndInputsAndClobbers(const ASTContext &C,
   unsigned NumExprs = NumOutputs + NumInputs;
 
   C.Deallocate(this->Names);
-  this->Names = new (C) IdentifierInfo*[NumExprs];
+  this->Names = C.AllocateStmtArray<IdentifierInfo*>(NumExprs);
   std::copy(Names, Names + NumExprs, this->Names);
 
   C.Deallocate(this->Exprs);
-  this->Exprs = new (C) Stmt*[NumExprs];
+  this->Exprs = C.AllocateStmtArray<Stmt*>(NumExprs);
   std::copy(Exprs, Exprs + NumExprs, this->Exprs);
 
   C.Deallocate(this->Constraints);
-  this->Constraints = new (C) StringLiteral*[NumExprs];
+  this->Constraints = C.AllocateStmtArray<StringLiteral*>(NumExprs);
   std::copy(Constraints, Constraints + NumExprs, this->Constraints);
 
   C.Deallocate(this->Clobbers);
-  this->Clobbers = new (C) StringLiteral*[NumClobbers];
+  this->Clobbers = C.AllocateStmtArray<StringLiteral*>(NumClobbers);
   std::copy(Clobbers, Clobbers + NumClobbers, this->Clobbers);
 }
 
@@ -638,16 +638,16 @@ GCCAsmStmt::GCCAsmStmt(const ASTContext &C, SourceLocation asmloc,
 
   unsigned NumExprs = NumOutputs + NumInputs;
 
-  Names = new (C) IdentifierInfo*[NumExprs];
+  Names = C.AllocateStmtArray<IdentifierInfo*>(NumExprs);
   std::copy(names, names + NumExprs, Names);
 
-  Exprs = new (C) Stmt*[NumExprs];
+  Exprs = C.AllocateStmtArray<Stmt*>(NumExprs);
   std::copy(exprs, exprs + NumExprs, Exprs);
 
-  Constraints = new (C) StringLiteral*[NumExprs];
+  Constraints = C.AllocateStmtArray<StringLiteral*>(NumExprs);
   std::copy(constraints, constraints + NumExprs, Constraints);
 
-  Clobbers = new (C) StringLiteral*[NumClobbers];
+  Clobbers = C.AllocateStmtArray<StringLiteral*>(NumClobbers);
   std::copy(clobbers, clobbers + NumClobbers, Clobbers);
 }
 
@@ -667,7 +667,7 @@ MSAsmStmt::MSAsmStmt(const ASTContext &C, SourceLocation asmloc,
 
 static StringRef copyIntoContext(const ASTContext &C, StringRef str) {
   size_t size = str.size();
-  char *buffer = new (C) char[size];
+  char *buffer = C.AllocateStmtArray<char>(size);
   memcpy(buffer, str.data(), size);
   return StringRef(buffer, size);
 }
@@ -686,20 +686,20 @@ void MSAsmStmt::initialize(const ASTContext &C, StringRef asmstr,
 
   AsmStr = copyIntoContext(C, asmstr);
 
-  Exprs = new (C) Stmt*[NumExprs];
+  Exprs = C.AllocateStmtArray<Stmt*>(NumExprs);
   for (unsigned i = 0, e = NumExprs; i != e; ++i)
     Exprs[i] = exprs[i];
 
-  AsmToks = new (C) Token[NumAsmToks];
+  AsmToks = C.AllocateStmtArray<Token>(NumAsmToks);
   for (unsigned i = 0, e = NumAsmToks; i != e; ++i)
     AsmToks[i] = asmtoks[i];
 
-  Constraints = new (C) StringRef[NumExprs];
+  Constraints = C.AllocateStmtArray<StringRef>(NumExprs);
   for (unsigned i = 0, e = NumExprs; i != e; ++i) {
     Constraints[i] = copyIntoContext(C, constraints[i]);
   }
 
-  Clobbers = new (C) StringRef[NumClobbers];
+  Clobbers = C.AllocateStmtArray<StringRef>(NumClobbers);
   for (unsigned i = 0, e = NumClobbers; i != e; ++i) {
     // FIXME: Avoid the allocation/copy if at all possible.
     Clobbers[i] = copyIntoContext(C, clobbers[i]);
@@ -740,7 +740,7 @@ ObjCAtTryStmt *ObjCAtTryStmt::Create(const ASTContext &Context,
                                      Stmt *atFinallyStmt) {
   unsigned Size = sizeof(ObjCAtTryStmt) +
     (1 + NumCatchStmts + (atFinallyStmt != 0)) * sizeof(Stmt *);
-  void *Mem = Context.Allocate(Size, llvm::alignOf<ObjCAtTryStmt>());
+  void *Mem = Context.AllocateStmt(Size, llvm::alignOf<ObjCAtTryStmt>());
   return new (Mem) ObjCAtTryStmt(atTryLoc, atTryStmt, CatchStmts, NumCatchStmts,
                                  atFinallyStmt);
 }
@@ -750,7 +750,7 @@ ObjCAtTryStmt *ObjCAtTryStmt::CreateEmpty(const ASTContext &Context,
                                           bool HasFinally) {
   unsigned Size = sizeof(ObjCAtTryStmt) +
     (1 + NumCatchStmts + HasFinally) * sizeof(Stmt *);
-  void *Mem = Context.Allocate(Size, llvm::alignOf<ObjCAtTryStmt>());
+  void *Mem = Context.AllocateStmt(Size, llvm::alignOf<ObjCAtTryStmt>());
   return new (Mem) ObjCAtTryStmt(EmptyShell(), NumCatchStmts, HasFinally);
 }
 
@@ -767,7 +767,7 @@ CXXTryStmt *CXXTryStmt::Create(const ASTContext &C, SourceLocation tryLoc,
   std::size_t Size = sizeof(CXXTryStmt);
   Size += ((handlers.size() + 1) * sizeof(Stmt));
 
-  void *Mem = C.Allocate(Size, llvm::alignOf<CXXTryStmt>());
+  void *Mem = C.AllocateStmt(Size, llvm::alignOf<CXXTryStmt>());
   return new (Mem) CXXTryStmt(tryLoc, tryBlock, handlers);
 }
 
@@ -776,7 +776,7 @@ CXXTryStmt *CXXTryStmt::Create(const ASTContext &C, EmptyShell Empty,
   std::size_t Size = sizeof(CXXTryStmt);
   Size += ((numHandlers + 1) * sizeof(Stmt));
 
-  void *Mem = C.Allocate(Size, llvm::alignOf<CXXTryStmt>());
+  void *Mem = C.AllocateStmt(Size, llvm::alignOf<CXXTryStmt>());
   return new (Mem) CXXTryStmt(Empty, numHandlers);
 }
 
@@ -1078,7 +1078,7 @@ CapturedStmt *CapturedStmt::Create(const ASTContext &Context, Stmt *S,
     Size += sizeof(Capture) * Captures.size();
   }
 
-  void *Mem = Context.Allocate(Size);
+  void *Mem = Context.AllocateStmt(Size);
   return new (Mem) CapturedStmt(S, Kind, Captures, CaptureInits, CD, RD);
 }
 
@@ -1091,7 +1091,7 @@ CapturedStmt *CapturedStmt::CreateDeserialized(const ASTContext &Context,
     Size += sizeof(Capture) * NumCaptures;
   }
 
-  void *Mem = Context.Allocate(Size);
+  void *Mem = Context.AllocateStmt(Size);
   return new (Mem) CapturedStmt(EmptyShell(), NumCaptures);
 }
 
@@ -1131,8 +1131,9 @@ OMPPrivateClause *OMPPrivateClause::Create(const ASTContext &C,
                                            SourceLocation LParenLoc,
                                            SourceLocation EndLoc,
                                            ArrayRef<Expr *> VL) {
-  void *Mem = C.Allocate(sizeof(OMPPrivateClause) + sizeof(Expr *) * VL.size(),
-                         llvm::alignOf<OMPPrivateClause>());
+  void *Mem = C.AllocateStmt(sizeof(OMPPrivateClause) +
+                             sizeof(Expr *) * VL.size(),
+                             llvm::alignOf<OMPPrivateClause>());
   OMPPrivateClause *Clause = new (Mem) OMPPrivateClause(StartLoc, LParenLoc,
                                                         EndLoc, VL.size());
   Clause->setVarRefs(VL);
@@ -1141,8 +1142,8 @@ OMPPrivateClause *OMPPrivateClause::Create(const ASTContext &C,
 
 OMPPrivateClause *OMPPrivateClause::CreateEmpty(const ASTContext &C,
                                                 unsigned N) {
-  void *Mem = C.Allocate(sizeof(OMPPrivateClause) + sizeof(Expr *) * N,
-                         llvm::alignOf<OMPPrivateClause>());
+  void *Mem = C.AllocateStmt(sizeof(OMPPrivateClause) + sizeof(Expr *) * N,
+                             llvm::alignOf<OMPPrivateClause>());
   return new (Mem) OMPPrivateClause(N);
 }
 
@@ -1151,9 +1152,9 @@ OMPFirstprivateClause *OMPFirstprivateClause::Create(const ASTContext &C,
                                                      SourceLocation LParenLoc,
                                                      SourceLocation EndLoc,
                                                      ArrayRef<Expr *> VL) {
-  void *Mem = C.Allocate(sizeof(OMPFirstprivateClause) +
-                         sizeof(Expr *) * VL.size(),
-                         llvm::alignOf<OMPFirstprivateClause>());
+  void *Mem = C.AllocateStmt(sizeof(OMPFirstprivateClause) +
+                             sizeof(Expr *) * VL.size(),
+                             llvm::alignOf<OMPFirstprivateClause>());
   OMPFirstprivateClause *Clause = new (Mem) OMPFirstprivateClause(StartLoc,
                                                                   LParenLoc,
                                                                   EndLoc,
@@ -1164,8 +1165,8 @@ OMPFirstprivateClause *OMPFirstprivateClause::Create(const ASTContext &C,
 
 OMPFirstprivateClause *OMPFirstprivateClause::CreateEmpty(const ASTContext &C,
                                                           unsigned N) {
-  void *Mem = C.Allocate(sizeof(OMPFirstprivateClause) + sizeof(Expr *) * N,
-                         llvm::alignOf<OMPFirstprivateClause>());
+  void *Mem = C.AllocateStmt(sizeof(OMPFirstprivateClause) + sizeof(Expr *) * N,
+                             llvm::alignOf<OMPFirstprivateClause>());
   return new (Mem) OMPFirstprivateClause(N);
 }
 
@@ -1174,8 +1175,9 @@ OMPSharedClause *OMPSharedClause::Create(const ASTContext &C,
                                          SourceLocation LParenLoc,
                                          SourceLocation EndLoc,
                                          ArrayRef<Expr *> VL) {
-  void *Mem = C.Allocate(sizeof(OMPSharedClause) + sizeof(Expr *) * VL.size(),
-                         llvm::alignOf<OMPSharedClause>());
+  void *Mem = C.AllocateStmt(sizeof(OMPSharedClause) +
+                             sizeof(Expr *) * VL.size(),
+                             llvm::alignOf<OMPSharedClause>());
   OMPSharedClause *Clause = new (Mem) OMPSharedClause(StartLoc, LParenLoc,
                                                       EndLoc, VL.size());
   Clause->setVarRefs(VL);
@@ -1184,8 +1186,8 @@ OMPSharedClause *OMPSharedClause::Create(const ASTContext &C,
 
 OMPSharedClause *OMPSharedClause::CreateEmpty(const ASTContext &C,
                                               unsigned N) {
-  void *Mem = C.Allocate(sizeof(OMPSharedClause) + sizeof(Expr *) * N,
-                         llvm::alignOf<OMPSharedClause>());
+  void *Mem = C.AllocateStmt(sizeof(OMPSharedClause) + sizeof(Expr *) * N,
+                             llvm::alignOf<OMPSharedClause>());
   return new (Mem) OMPSharedClause(N);
 }
 
@@ -1201,9 +1203,10 @@ OMPParallelDirective *OMPParallelDirective::Create(
                                               SourceLocation EndLoc,
                                               ArrayRef<OMPClause *> Clauses,
                                               Stmt *AssociatedStmt) {
-  void *Mem = C.Allocate(sizeof(OMPParallelDirective) +
-                         sizeof(OMPClause *) * Clauses.size() + sizeof(Stmt *),
-                         llvm::alignOf<OMPParallelDirective>());
+  void *Mem = C.AllocateStmt(sizeof(OMPParallelDirective) +
+                             sizeof(OMPClause *) * Clauses.size() +
+                             sizeof(Stmt *),
+                             llvm::alignOf<OMPParallelDirective>());
   OMPParallelDirective *Dir = new (Mem) OMPParallelDirective(StartLoc, EndLoc,
                                                              Clauses.size());
   Dir->setClauses(Clauses);
@@ -1214,9 +1217,9 @@ OMPParallelDirective *OMPParallelDirective::Create(
 OMPParallelDirective *OMPParallelDirective::CreateEmpty(const ASTContext &C,
                                                         unsigned N,
                                                         EmptyShell) {
-  void *Mem = C.Allocate(sizeof(OMPParallelDirective) +
-                         sizeof(OMPClause *) * N + sizeof(Stmt *),
-                         llvm::alignOf<OMPParallelDirective>());
+  void *Mem = C.AllocateStmt(sizeof(OMPParallelDirective) +
+                             sizeof(OMPClause *) * N + sizeof(Stmt *),
+                             llvm::alignOf<OMPParallelDirective>());
   return new (Mem) OMPParallelDirective(N);
 }
 
@@ -1238,14 +1241,14 @@ Flowfact *Flowfact::Create(const ASTContext &C,
                            int rhs) {
   // XXX this is not he clang way of allocating the Flowfact statement, at least
   // the LHS terms should be stored as sub-expressions and allocated here
-  void *Mem = C.Allocate(sizeof(Flowfact),
-                         llvm::alignOf<Flowfact>());
+  void *Mem = C.AllocateStmt(sizeof(Flowfact),
+                             llvm::alignOf<Flowfact>());
   return new (Mem) Flowfact(Range, Multipliers, Markers, rhs);
 }
 
 Flowfact *Flowfact::CreateEmpty(const ASTContext &C) {
-  void *Mem = C.Allocate(sizeof(Flowfact),
-                         llvm::alignOf<Flowfact>());
+  void *Mem = C.AllocateStmt(sizeof(Flowfact),
+                             llvm::alignOf<Flowfact>());
   return new (Mem) Flowfact(SourceRange(),
                             ArrayRef<int>(),
                             ArrayRef<std::string>(),
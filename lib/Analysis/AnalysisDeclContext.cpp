@@ -30,6 +30,7 @@
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Support/SaveAndRestore.h"
+#include <algorithm>
 
 using namespace clang;
 
@@ -69,7 +70,7 @@ AnalysisDeclContextManager::AnalysisDeclContextManager(bool useUnoptimizedCFG,
                                                        bool addTemporaryDtors,
                                                        bool synthesizeBodies,
                                                        bool addStaticInitBranch)
-  : SynthesizeBodies(synthesizeBodies)
+  : UseCounter(0), SynthesizeBodies(synthesizeBodies)
 {
   cfgBuildOptions.PruneTriviallyFalseEdges = !useUnoptimizedCFG;
   cfgBuildOptions.AddImplicitDtors = addImplicitDtors;
@@ -82,6 +83,37 @@ void AnalysisDeclContextManager::clear() {
   for (ContextMap::iterator I = Contexts.begin(), E = Contexts.end(); I!=E; ++I)
     delete I->second;
   Contexts.clear();
+  LastUse.clear();
+}
+
+unsigned
+AnalysisDeclContextManager::clearLeastRecentlyUsed(unsigned MaxContexts) {
+  unsigned NumContexts = Contexts.size();
+  if (NumContexts <= MaxContexts)
+    return 0;
+  if (MaxContexts == 0) {
+    clear();
+    return NumContexts;
+  }
+
+  // The uses are numbered uniquely, so exactly MaxContexts contexts were used
+  // at or after the threshold.
+  std::vector<unsigned> Uses;
+  Uses.reserve(Contexts.size());
+  for (ContextMap::iterator I = Contexts.begin(), E = Contexts.end(); I!=E; ++I)
+    Uses.push_back(LastUse[I->first]);
+  std::vector<unsigned>::iterator Threshold = Uses.end() - MaxContexts;
+  std::nth_element(Uses.begin(), Threshold, Uses.end());
+
+  for (ContextMap::iterator I = Contexts.begin(), E = Contexts.end(); I!=E; ) {
+    ContextMap::iterator Cur = I++;
+    if (LastUse[Cur->first] < *Threshold) {
+      delete Cur->second;
+      LastUse.erase(Cur->first);
+      Contexts.erase(Cur);
+    }
+  }
+  return NumContexts - Contexts.size();
 }
 
 static BodyFarm &getBodyFarm(ASTContext &C) {
@@ -263,6 +295,7 @@ AnalysisDeclContext *AnalysisDeclContextManager::getContext(const Decl *D) {
     D = FD;
   }
 
+  LastUse[D] = ++UseCounter;
   AnalysisDeclContext *&AC = Contexts[D];
   if (!AC)
     AC = new AnalysisDeclContext(this, D, cfgBuildOptions);
@@ -0,0 +1,45 @@
+//===- DataflowWorklist.cpp - Worklist of CFG blocks for dataflow ---------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements DataflowWorklist, the worklist of CFG blocks shared by
+// the dataflow analyses over source-level CFGs.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/Analysis/Analyses/DataflowWorklist.h"
+
+using namespace clang;
+
+void DataflowWorklist::enqueueBlock(const CFGBlock *Block) {
+  if (Block && !EnqueuedBlocks[Block->getBlockID()]) {
+    EnqueuedBlocks[Block->getBlockID()] = true;
+    Worklist.push(Block);
+  }
+}
+
+void DataflowWorklist::enqueueSuccessors(const CFGBlock *Block) {
+  for (CFGBlock::const_succ_iterator I = Block->succ_begin(),
+       E = Block->succ_end(); I != E; ++I)
+    enqueueBlock(*I);
+}
+
+void DataflowWorklist::enqueuePredecessors(const CFGBlock *Block) {
+  for (CFGBlock::const_pred_iterator I = Block->pred_begin(),
+       E = Block->pred_end(); I != E; ++I)
+    enqueueBlock(*I);
+}
+
+const CFGBlock *DataflowWorklist::dequeue() {
+  if (Worklist.empty())
+    return 0;
+  const CFGBlock *B = Worklist.top();
+  Worklist.pop();
+  EnqueuedBlocks[B->getBlockID()] = false;
+  return B;
+}
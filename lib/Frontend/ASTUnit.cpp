@@ -227,6 +227,7 @@ ASTUnit::ASTUnit(bool _MainFileIsAST)
     NumWarningsInPreamble(0),
     ShouldCacheCodeCompletionResults(false),
     IncludeBriefCommentsInCodeCompletion(false), UserFilesAreVolatile(false),
+    DeferPreambleRebuild(false), PreambleIsStale(false),
     CompletionCacheTopLevelHashValue(0),
     PreambleTopLevelHashValue(0),
     CurrentTopLevelHashValue(0),
@@ -1195,6 +1196,7 @@ bool ASTUnit::Parse(llvm::MemoryBuffer *OverrideMainBuffer) {
                                                     = PreambleEndsAtStartOfLine;
     PreprocessorOpts.ImplicitPCHInclude = getPreambleFile(this);
     PreprocessorOpts.DisablePCHValidation = true;
+    PreprocessorOpts.StalePrecompiledPreamble = PreambleIsStale;
     
     // The stored diagnostic has the old source manager in it; update
     // the locations to refer into the new source manager. Since we've
@@ -1359,6 +1361,19 @@ static llvm::MemoryBuffer *CreatePaddedMainFileBuffer(llvm::MemoryBuffer *Old,
   return Result;
 }
 
+/// \brief Determine whether the file \p Filename no longer has the size and
+/// modification time in \p Stamp on disk.
+static bool hasFileChangedOnDisk(FileManager &FileMgr, StringRef Filename,
+                                 std::pair<off_t, time_t> Stamp) {
+  llvm::sys::fs::file_status Status;
+  // If we can't stat the file, assume that something horrible happened.
+  if (FileMgr.getNoncachedStatValue(Filename, Status))
+    return true;
+  return Status.getSize() != uint64_t(Stamp.first) ||
+         Status.getLastModificationTime().toEpochTime() !=
+             uint64_t(Stamp.second);
+}
+
 /// \brief Attempt to build or re-use a precompiled preamble when (re-)parsing
 /// the source file.
 ///
@@ -1376,14 +1391,20 @@ static llvm::MemoryBuffer *CreatePaddedMainFileBuffer(llvm::MemoryBuffer *Old,
 /// \param MaxLines When non-zero, the maximum number of lines that
 /// can occur within the preamble.
 ///
+/// \param AllowStale When true, the precompiled preamble is re-used even if
+/// some of the files it was built from have changed, as long as the preamble
+/// of the main source file itself is unchanged.
+///
 /// \returns If the precompiled preamble can be used, returns a newly-allocated
 /// buffer that should be used in place of the main file when doing so.
 /// Otherwise, returns a NULL pointer.
 llvm::MemoryBuffer *ASTUnit::getMainBufferWithPrecompiledPreamble(
                               const CompilerInvocation &PreambleInvocationIn,
                                                            bool AllowRebuild,
-                                                           unsigned MaxLines) {
-  
+                                                           unsigned MaxLines,
+                                                           bool AllowStale) {
+  PreambleIsStale = false;
+
   IntrusiveRefCntPtr<CompilerInvocation>
     PreambleInvocation(new CompilerInvocation(PreambleInvocationIn));
   FrontendOptions &FrontendOpts = PreambleInvocation->getFrontendOpts();
@@ -1425,6 +1446,12 @@ llvm::MemoryBuffer *ASTUnit::getMainBufferWithPrecompiledPreamble(
 
       // Check that none of the files used by the preamble have changed.
       bool AnyFileChanged = false;
+
+      // Whether an out-of-date preamble can still be used. The AST reader
+      // reads the files included by the preamble from disk, so this is only
+      // the case when every changed file is now remapped but was not when the
+      // preamble was built, and is still the same on disk.
+      bool CanUseStale = AllowStale;
           
       // First, make a record of those files that have been overridden via
       // remapping or unsaved_files.
@@ -1439,6 +1466,7 @@ llvm::MemoryBuffer *ASTUnit::getMainBufferWithPrecompiledPreamble(
           // If we can't stat the file we're remapping to, assume that something
           // horrible happened.
           AnyFileChanged = true;
+          CanUseStale = false;
           break;
         }
 
@@ -1459,29 +1487,36 @@ llvm::MemoryBuffer *ASTUnit::getMainBufferWithPrecompiledPreamble(
       // Check whether anything has changed.
       for (llvm::StringMap<std::pair<off_t, time_t> >::iterator 
              F = FilesInPreamble.begin(), FEnd = FilesInPreamble.end();
-           !AnyFileChanged && F != FEnd; 
+           (!AnyFileChanged || CanUseStale) && F != FEnd;
            ++F) {
         llvm::StringMap<std::pair<off_t, time_t> >::iterator Overridden
           = OverriddenFiles.find(F->first());
         if (Overridden != OverriddenFiles.end()) {
           // This file was remapped; check whether the newly-mapped file 
           // matches up with the previous mapping.
-          if (Overridden->second != F->second)
+          if (Overridden->second != F->second) {
             AnyFileChanged = true;
+            if (OverriddenFilesInPreamble.count(F->first()) ||
+                hasFileChangedOnDisk(*FileMgr, F->first(), F->second))
+              CanUseStale = false;
+          }
           continue;
         }
         
         // The file was not remapped; check whether it has changed on disk.
-        llvm::sys::fs::file_status Status;
-        if (FileMgr->getNoncachedStatValue(F->first(), Status)) {
-          // If we can't stat the file, assume that something horrible happened.
-          AnyFileChanged = true;
-        } else if (Status.getSize() != uint64_t(F->second.first) ||
-                   Status.getLastModificationTime().toEpochTime() !=
-                       uint64_t(F->second.second))
+        if (hasFileChangedOnDisk(*FileMgr, F->first(), F->second)) {
           AnyFileChanged = true;
+          CanUseStale = false;
+        }
       }
           
+      // Keep using an out-of-date preamble if the client asked us to and
+      // its source locations are still valid; the rebuild is left for later.
+      if (AnyFileChanged && CanUseStale) {
+        AnyFileChanged = false;
+        PreambleIsStale = true;
+      }
+
       if (!AnyFileChanged) {
         // Okay! We can re-use the precompiled preamble.
 
@@ -1670,6 +1705,7 @@ llvm::MemoryBuffer *ASTUnit::getMainBufferWithPrecompiledPreamble(
   // Keep track of all of the files that the source manager knows about,
   // so we can verify whether they have changed or not.
   FilesInPreamble.clear();
+  OverriddenFilesInPreamble.clear();
   SourceManager &SourceMgr = Clang->getSourceManager();
   const llvm::MemoryBuffer *MainFileBuffer
     = SourceMgr.getBuffer(SourceMgr.getMainFileID());
@@ -1683,6 +1719,8 @@ llvm::MemoryBuffer *ASTUnit::getMainBufferWithPrecompiledPreamble(
     
     FilesInPreamble[File->getName()]
       = std::make_pair(F->second->getSize(), File->getModificationTime());
+    if (SourceMgr.isFileOverridden(File))
+      OverriddenFilesInPreamble.insert(File->getName());
   }
   
   PreambleRebuildCounter = 1;
@@ -2077,7 +2115,8 @@ ASTUnit *ASTUnit::LoadFromCommandLine(const char **ArgBegin,
   return AST.take();
 }
 
-bool ASTUnit::Reparse(RemappedFile *RemappedFiles, unsigned NumRemappedFiles) {
+bool ASTUnit::Reparse(RemappedFile *RemappedFiles, unsigned NumRemappedFiles,
+                      bool RebuildStalePreamble) {
   if (!Invocation)
     return true;
 
@@ -2113,7 +2152,10 @@ bool ASTUnit::Reparse(RemappedFile *RemappedFiles, unsigned NumRemappedFiles) {
   // build a precompiled preamble, do so now.
   llvm::MemoryBuffer *OverrideMainBuffer = 0;
   if (!getPreambleFile(this).empty() || PreambleRebuildCounter > 0)
-    OverrideMainBuffer = getMainBufferWithPrecompiledPreamble(*Invocation);
+    OverrideMainBuffer
+      = getMainBufferWithPrecompiledPreamble(*Invocation, /*AllowRebuild=*/true,
+                                             /*MaxLines=*/0,
+                                DeferPreambleRebuild && !RebuildStalePreamble);
     
   // Clear out the diagnostics state.
   getDiagnostics().Reset();
@@ -2496,7 +2538,8 @@ void ASTUnit::CodeComplete(StringRef File, unsigned Line, unsigned Column,
         if (CompleteFileID == MainID && Line > 1)
           OverrideMainBuffer
             = getMainBufferWithPrecompiledPreamble(*CCInvocation, false, 
-                                                   Line - 1);
+                                                   Line - 1,
+                                                   DeferPreambleRebuild);
       }
     }
   }
@@ -2510,11 +2553,13 @@ void ASTUnit::CodeComplete(StringRef File, unsigned Line, unsigned Column,
                                                     = PreambleEndsAtStartOfLine;
     PreprocessorOpts.ImplicitPCHInclude = getPreambleFile(this);
     PreprocessorOpts.DisablePCHValidation = true;
+    PreprocessorOpts.StalePrecompiledPreamble = PreambleIsStale;
     
     OwnedBuffers.push_back(OverrideMainBuffer);
   } else {
     PreprocessorOpts.PrecompiledPreambleBytes.first = 0;
     PreprocessorOpts.PrecompiledPreambleBytes.second = false;
+    PreprocessorOpts.StalePrecompiledPreamble = false;
   }
 
   // Disable the preprocessing record if modules are not enabled.
@@ -280,6 +280,28 @@ static bool ParseAnalyzerArgs(AnalyzerOptions &Opts, ArgList &Args,
     }
   }
 
+  // Check that the shard of the analysis to perform exists.
+  unsigned ShardCount = 1;
+  if (Opts.Config.count("shard-count")) {
+    StringRef Val = Opts.Config["shard-count"];
+    if (Val.getAsInteger(10, ShardCount) || ShardCount == 0) {
+      Diags.Report(SourceLocation(),
+                   diag::err_analyzer_config_invalid_shard_count) << Val;
+      Success = false;
+      ShardCount = 1;
+    }
+  }
+  if (Opts.Config.count("shard-index")) {
+    StringRef Val = Opts.Config["shard-index"];
+    unsigned ShardIndex;
+    if (Val.getAsInteger(10, ShardIndex) || ShardIndex >= ShardCount) {
+      Diags.Report(SourceLocation(),
+                   diag::err_analyzer_config_invalid_shard_index)
+        << ShardCount << Val;
+      Success = false;
+    }
+  }
+
   return Success;
 }
 
@@ -1339,8 +1361,11 @@ static void ParseLangArgs(LangOptions &Opts, ArgList &Args, InputKind IK,
       getLastArgIntValue(Args, OPT_fconstexpr_depth, 512, Diags);
   Opts.ConstexprStepLimit =
       getLastArgIntValue(Args, OPT_fconstexpr_steps, 1048576, Diags);
+  Opts.CheckConstexprMemoization =
+      Args.hasArg(OPT_fconstexpr_check_memoization);
   Opts.BracketDepth = getLastArgIntValue(Args, OPT_fbracket_depth, 256, Diags);
   Opts.DelayedTemplateParsing = Args.hasArg(OPT_fdelayed_template_parsing);
+  Opts.PCHInstantiateTemplates = Args.hasArg(OPT_fpch_instantiate_templates);
   Opts.NumLargeByValueCopy =
       getLastArgIntValue(Args, OPT_Wlarge_by_value_copy_EQ, 0, Diags);
   Opts.MSBitfields = Args.hasArg(OPT_mms_bitfields);
@@ -1476,6 +1501,7 @@ static void ParsePreprocessorArgs(PreprocessorOptions &Opts, ArgList &Args,
   Opts.UsePredefines = !Args.hasArg(OPT_undef);
   Opts.DetailedRecord = Args.hasArg(OPT_detailed_preprocessing_record);
   Opts.DisablePCHValidation = Args.hasArg(OPT_fno_validate_pch);
+  Opts.CompressPCHBuffers = Args.hasArg(OPT_fcompress_pch_buffers);
 
   Opts.DumpDeserializedPCHDecls = Args.hasArg(OPT_dump_deserialized_pch_decls);
   for (arg_iterator it = Args.filtered_begin(OPT_error_on_deserialized_pch_decl),
@@ -1747,12 +1747,16 @@ AnalysisBasedWarnings::IssueWarnings(sema::AnalysisBasedWarnings::Policy P,
     Analyzer.run(AC);
   }
 
-  if (Diags.getDiagnosticLevel(diag::warn_uninit_var, D->getLocStart())
-      != DiagnosticsEngine::Ignored ||
-      Diags.getDiagnosticLevel(diag::warn_sometimes_uninit_var,D->getLocStart())
-      != DiagnosticsEngine::Ignored ||
-      Diags.getDiagnosticLevel(diag::warn_maybe_uninit_var, D->getLocStart())
-      != DiagnosticsEngine::Ignored) {
+  // Functions without local scalar variables are common and cannot have
+  // uninitialized uses, so do not build a CFG just to find that out.
+  if ((Diags.getDiagnosticLevel(diag::warn_uninit_var, D->getLocStart())
+       != DiagnosticsEngine::Ignored ||
+       Diags.getDiagnosticLevel(diag::warn_sometimes_uninit_var,
+                                D->getLocStart())
+       != DiagnosticsEngine::Ignored ||
+       Diags.getDiagnosticLevel(diag::warn_maybe_uninit_var, D->getLocStart())
+       != DiagnosticsEngine::Ignored) &&
+      hasTrackedUninitializedVariables(*cast<DeclContext>(D))) {
     if (CFG *cfg = AC.getCFG()) {
       UninitValsDiagReporter reporter(S);
       UninitVariablesAnalysisStats stats;
@@ -605,6 +605,23 @@ void Sema::ActOnEndOfTranslationUnit() {
     // name that was not visible at its first point of instantiation.
     PerformPendingInstantiations();
     CheckDelayedMemberExceptionSpecs();
+  } else if (LangOpts.PCHInstantiateTemplates) {
+    // Perform the implicit instantiations requested by the PCH itself, so
+    // that their bodies are stored in it instead of being instantiated again
+    // by every translation unit that uses it.
+    //
+    // The used vtables are not defined here: DefineUsedVTables would consume
+    // VTableUses, which are stored in the PCH so that the translation units,
+    // where the vtables are emitted, define them.
+    PerformPendingInstantiations();
+    CheckDelayedMemberExceptionSpecs();
+
+    // The instantiations of templates that are not defined yet are left to
+    // the translation units, which may define them.
+    PendingInstantiations.insert(PendingInstantiations.end(),
+                                 DeferredPCHInstantiations.begin(),
+                                 DeferredPCHInstantiations.end());
+    DeferredPCHInstantiations.clear();
   }
 
   // All delayed member exception specs should be checked or we end up accepting
@@ -5489,9 +5489,6 @@ Sema::AddOverloadCandidate(FunctionDecl *Function,
       Constructor->isMoveConstructor())
     return;
 
-  // Overload resolution is always an unevaluated context.
-  EnterExpressionEvaluationContext Unevaluated(*this, Sema::Unevaluated);
-
   if (Constructor) {
     // C++ [class.copy]p3:
     //   A member function template is never instantiated to perform the copy
@@ -5538,6 +5535,10 @@ Sema::AddOverloadCandidate(FunctionDecl *Function,
     return;
   }
 
+  // Overload resolution is always an unevaluated context. Candidates that
+  // are ruled out by their arity alone are rejected before entering it.
+  EnterExpressionEvaluationContext Unevaluated(*this, Sema::Unevaluated);
+
   // (CUDA B.1): Check for invalid calls between targets.
   if (getLangOpts().CUDA)
     if (const FunctionDecl *Caller = dyn_cast<FunctionDecl>(CurContext))
@@ -5674,9 +5675,6 @@ Sema::AddMethodCandidate(CXXMethodDecl *Method, DeclAccessPair FoundDecl,
       Method->isMoveAssignmentOperator())
     return;
 
-  // Overload resolution is always an unevaluated context.
-  EnterExpressionEvaluationContext Unevaluated(*this, Sema::Unevaluated);
-
   // Add this candidate
   OverloadCandidate &Candidate = CandidateSet.addCandidate(Args.size() + 1);
   Candidate.FoundDecl = FoundDecl;
@@ -5709,6 +5707,9 @@ Sema::AddMethodCandidate(CXXMethodDecl *Method, DeclAccessPair FoundDecl,
     return;
   }
 
+  // Overload resolution is always an unevaluated context.
+  EnterExpressionEvaluationContext Unevaluated(*this, Sema::Unevaluated);
+
   Candidate.Viable = true;
 
   if (Method->isStatic() || ObjectType.isNull())
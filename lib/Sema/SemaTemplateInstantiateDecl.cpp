@@ -4547,6 +4547,20 @@ NamedDecl *Sema::FindInstantiatedDecl(SourceLocation Loc, NamedDecl *D,
   return D;
 }
 
+/// \brief Determine whether the template from which \p D would be
+/// instantiated has a definition yet.
+static bool hasInstantiationPatternDefinition(ValueDecl *D) {
+  if (FunctionDecl *Function = dyn_cast<FunctionDecl>(D)) {
+    const FunctionDecl *Pattern = Function->getTemplateInstantiationPattern();
+    return !Pattern || Pattern->isDefined();
+  }
+
+  VarDecl *Var = cast<VarDecl>(D);
+  if (VarDecl *Pattern = Var->getInstantiatedFromStaticDataMember())
+    return Pattern->getDefinition() != 0;
+  return true;
+}
+
 /// \brief Performs template instantiation for all implicit template
 /// instantiations we have seen until this point.
 void Sema::PerformPendingInstantiations(bool LocalOnly) {
@@ -4570,6 +4584,14 @@ void Sema::PerformPendingInstantiations(bool LocalOnly) {
       PendingLocalImplicitInstantiations.pop_front();
     }
 
+    // When instantiating templates in a PCH, the template may only be defined
+    // by the translation units that use it. Leave the instantiation to them.
+    if (TUKind == TU_Prefix && LangOpts.PCHInstantiateTemplates &&
+        !hasInstantiationPatternDefinition(Inst.first)) {
+      DeferredPCHInstantiations.push_back(Inst);
+      continue;
+    }
+
     // Instantiate function definitions
     if (FunctionDecl *Function = dyn_cast<FunctionDecl>(Inst.first)) {
       PrettyDeclStackTraceEntry CrashInfo(*this, Function, SourceLocation(),
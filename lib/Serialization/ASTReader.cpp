@@ -44,6 +44,7 @@
 #include "llvm/ADT/Hashing.h"
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/Bitcode/BitstreamReader.h"
+#include "llvm/Support/Compression.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MemoryBuffer.h"
@@ -882,6 +883,27 @@ bool ASTReader::ReadSourceManagerBlock(ModuleFile &F) {
   }
 }
 
+/// \brief Create a memory buffer holding the contents of a buffer blob
+/// record, decompressing them if necessary.
+///
+/// \returns the new buffer, or NULL if the record is not a buffer blob or its
+/// contents could not be decompressed.
+static llvm::MemoryBuffer *
+createBufferFromBlob(unsigned RecCode, const ASTReader::RecordData &Record,
+                     StringRef Blob, StringRef Name) {
+  if (RecCode == SM_SLOC_BUFFER_BLOB)
+    return llvm::MemoryBuffer::getMemBuffer(Blob.drop_back(1), Name);
+
+  if (RecCode != SM_SLOC_BUFFER_BLOB_COMPRESSED || Record.empty())
+    return 0;
+
+  OwningPtr<llvm::MemoryBuffer> Uncompressed;
+  if (llvm::zlib::uncompress(Blob, Uncompressed, Record[0])
+        != llvm::zlib::StatusOK)
+    return 0;
+  return llvm::MemoryBuffer::getMemBufferCopy(Uncompressed->getBuffer(), Name);
+}
+
 /// \brief If a header file is not found at the path that we expect it to be
 /// and the PCH file was moved from its original location, try to resolve the
 /// file by assuming that header+PCH were moved together and the header is in
@@ -988,14 +1010,13 @@ bool ASTReader::ReadSLocEntry(int ID) {
       unsigned Code = SLocEntryCursor.ReadCode();
       Record.clear();
       unsigned RecCode = SLocEntryCursor.readRecord(Code, Record, &Blob);
-      
-      if (RecCode != SM_SLOC_BUFFER_BLOB) {
+      llvm::MemoryBuffer *Buffer
+        = createBufferFromBlob(RecCode, Record, Blob, File->getName());
+      if (!Buffer) {
         Error("AST record has invalid code");
         return true;
       }
-      
-      llvm::MemoryBuffer *Buffer
-        = llvm::MemoryBuffer::getMemBuffer(Blob.drop_back(1), File->getName());
+
       SourceMgr.overrideFileContents(File, Buffer);
     }
 
@@ -1015,14 +1036,13 @@ bool ASTReader::ReadSLocEntry(int ID) {
     Record.clear();
     unsigned RecCode
       = SLocEntryCursor.readRecord(Code, Record, &Blob);
-
-    if (RecCode != SM_SLOC_BUFFER_BLOB) {
+    llvm::MemoryBuffer *Buffer
+      = createBufferFromBlob(RecCode, Record, Blob, Name);
+    if (!Buffer) {
       Error("AST record has invalid code");
       return true;
     }
 
-    llvm::MemoryBuffer *Buffer
-      = llvm::MemoryBuffer::getMemBuffer(Blob.drop_back(1), Name);
     SourceMgr.createFileIDForMemBuffer(Buffer, FileCharacter, ID,
                                        BaseOffset + Offset, IncludeLoc);
     break;
@@ -1701,7 +1721,9 @@ InputFile ASTReader::getInputFile(ModuleFile &F, unsigned ID, bool Complain) {
     // PCH.
     SourceManager &SM = getSourceManager();
     if (!Overridden && SM.isFileOverridden(File)) {
-      if (Complain)
+      // A stale precompiled preamble is only used when the file is unchanged
+      // on disk, which is what we recover to.
+      if (Complain && !PP.getPreprocessorOpts().StalePrecompiledPreamble)
         Error(diag::err_fe_pch_file_overridden, Filename);
       // After emitting the diagnostic, recover by disabling the override so
       // that the original file will be used.
@@ -45,6 +45,7 @@
 #include "llvm/ADT/Hashing.h"
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/Bitcode/BitstreamWriter.h"
+#include "llvm/Support/Compression.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
@@ -855,6 +856,7 @@ void ASTWriter::WriteBlockInfoBlock() {
   RECORD(SM_SLOC_FILE_ENTRY);
   RECORD(SM_SLOC_BUFFER_ENTRY);
   RECORD(SM_SLOC_BUFFER_BLOB);
+  RECORD(SM_SLOC_BUFFER_BLOB_COMPRESSED);
   RECORD(SM_SLOC_EXPANSION_ENTRY);
 
   // Preprocessor Block.
@@ -1434,6 +1436,47 @@ static unsigned CreateSLocBufferBlobAbbrev(llvm::BitstreamWriter &Stream) {
   return Stream.EmitAbbrev(Abbrev);
 }
 
+/// \brief Create an abbreviation for the SLocEntry that refers to a
+/// buffer's compressed blob.
+static unsigned CreateSLocBufferBlobCompressedAbbrev(
+                                              llvm::BitstreamWriter &Stream) {
+  using namespace llvm;
+  BitCodeAbbrev *Abbrev = new BitCodeAbbrev();
+  Abbrev->Add(BitCodeAbbrevOp(SM_SLOC_BUFFER_BLOB_COMPRESSED));
+  Abbrev->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::VBR, 8)); // Uncompressed size
+  Abbrev->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::Blob)); // Compressed blob
+  return Stream.EmitAbbrev(Abbrev);
+}
+
+/// \brief Emit the contents of a buffer, compressing them if requested
+/// and supported.
+static void EmitSLocBufferBlob(llvm::BitstreamWriter &Stream,
+                               const llvm::MemoryBuffer *Buffer,
+                               unsigned SLocBufferBlobAbbrv,
+                               unsigned SLocBufferBlobCompressedAbbrv,
+                               bool Compress) {
+  SmallVector<uint64_t, 2> Record;
+  StringRef Contents = Buffer->getBuffer();
+  if (Compress && llvm::zlib::isAvailable()) {
+    OwningPtr<llvm::MemoryBuffer> Compressed;
+    if (llvm::zlib::compress(Contents, Compressed) == llvm::zlib::StatusOK &&
+        Compressed->getBufferSize() < Contents.size()) {
+      Record.push_back(SM_SLOC_BUFFER_BLOB_COMPRESSED);
+      Record.push_back(Contents.size());
+      Stream.EmitRecordWithBlob(SLocBufferBlobCompressedAbbrv, Record,
+                                Compressed->getBuffer());
+      return;
+    }
+  }
+
+  // We add one to the size so that we capture the trailing NULL
+  // that is required by llvm::MemoryBuffer::getMemBuffer (on
+  // the reader side).
+  Record.push_back(SM_SLOC_BUFFER_BLOB);
+  Stream.EmitRecordWithBlob(SLocBufferBlobAbbrv, Record,
+                            StringRef(Contents.data(), Contents.size() + 1));
+}
+
 /// \brief Create an abbreviation for the SLocEntry that refers to a macro
 /// expansion.
 static unsigned CreateSLocExpansionAbbrev(llvm::BitstreamWriter &Stream) {
@@ -1644,7 +1687,10 @@ void ASTWriter::WriteSourceManagerBlock(SourceManager &SourceMgr,
   unsigned SLocFileAbbrv = CreateSLocFileAbbrev(Stream);
   unsigned SLocBufferAbbrv = CreateSLocBufferAbbrev(Stream);
   unsigned SLocBufferBlobAbbrv = CreateSLocBufferBlobAbbrev(Stream);
+  unsigned SLocBufferBlobCompressedAbbrv
+    = CreateSLocBufferBlobCompressedAbbrev(Stream);
   unsigned SLocExpansionAbbrv = CreateSLocExpansionAbbrev(Stream);
+  bool CompressBuffers = PP.getPreprocessorOpts().CompressPCHBuffers;
 
   // Write out the source location entry table. We skip the first
   // entry, which is always the same dummy entry.
@@ -1705,31 +1751,21 @@ void ASTWriter::WriteSourceManagerBlock(SourceManager &SourceMgr,
         Stream.EmitRecordWithAbbrev(SLocFileAbbrv, Record);
         
         if (Content->BufferOverridden) {
-          Record.clear();
-          Record.push_back(SM_SLOC_BUFFER_BLOB);
           const llvm::MemoryBuffer *Buffer
             = Content->getBuffer(PP.getDiagnostics(), PP.getSourceManager());
-          Stream.EmitRecordWithBlob(SLocBufferBlobAbbrv, Record,
-                                    StringRef(Buffer->getBufferStart(),
-                                              Buffer->getBufferSize() + 1));          
+          EmitSLocBufferBlob(Stream, Buffer, SLocBufferBlobAbbrv,
+                             SLocBufferBlobCompressedAbbrv, CompressBuffers);
         }
       } else {
         // The source location entry is a buffer. The blob associated
         // with this entry contains the contents of the buffer.
-
-        // We add one to the size so that we capture the trailing NULL
-        // that is required by llvm::MemoryBuffer::getMemBuffer (on
-        // the reader side).
         const llvm::MemoryBuffer *Buffer
           = Content->getBuffer(PP.getDiagnostics(), PP.getSourceManager());
         const char *Name = Buffer->getBufferIdentifier();
         Stream.EmitRecordWithBlob(SLocBufferAbbrv, Record,
                                   StringRef(Name, strlen(Name) + 1));
-        Record.clear();
-        Record.push_back(SM_SLOC_BUFFER_BLOB);
-        Stream.EmitRecordWithBlob(SLocBufferBlobAbbrv, Record,
-                                  StringRef(Buffer->getBufferStart(),
-                                                  Buffer->getBufferSize() + 1));
+        EmitSLocBufferBlob(Stream, Buffer, SLocBufferBlobAbbrv,
+                           SLocBufferBlobCompressedAbbrv, CompressBuffers);
 
         if (strcmp(Name, "<built-in>") == 0) {
           PreloadSLocs.push_back(SLocEntryOffsets.size());
@@ -65,6 +65,25 @@ IPAKind AnalyzerOptions::getIPAMode() {
   return IPAMode;
 }
 
+ExplorationStrategyKind AnalyzerOptions::getExplorationStrategy() {
+  if (ExplorationStrategy == ESK_NotSet) {
+    StringRef StratStr(Config.GetOrCreateValue("exploration-strategy",
+                                               "dfs").getValue());
+    ExplorationStrategyKind Strat
+      = llvm::StringSwitch<ExplorationStrategyKind>(StratStr)
+            .Case("dfs", ESK_DFS)
+            .Case("bfs", ESK_BFS)
+            .Case("bfs-block-dfs-contents", ESK_BFSBlockDFSContents)
+            .Case("unexplored-first", ESK_UnexploredFirst)
+            .Default(ESK_NotSet);
+    assert(Strat != ESK_NotSet && "Exploration strategy is invalid.");
+
+    ExplorationStrategy = Strat;
+  }
+
+  return ExplorationStrategy;
+}
+
 bool
 AnalyzerOptions::mayInlineCXXMemberFunction(CXXInlineableMemberKind K) {
   if (getIPAMode() < IPAK_Inlining)
@@ -196,6 +215,11 @@ int AnalyzerOptions::getOptionAsInteger(StringRef Name, int DefaultVal) {
   return Res;
 }
 
+StringRef AnalyzerOptions::getOptionAsString(StringRef Name,
+                                             StringRef DefaultVal) {
+  return Config.GetOrCreateValue(Name, DefaultVal).getValue();
+}
+
 unsigned AnalyzerOptions::getAlwaysInlineSize() {
   if (!AlwaysInlineSize.hasValue())
     AlwaysInlineSize = getOptionAsInteger("ipa-always-inline-size", 3);
@@ -254,6 +278,34 @@ unsigned AnalyzerOptions::getMaxNodesPerTopLevelFunction() {
   return MaxNodesPerTopLevelFunction.getValue();
 }
 
+unsigned AnalyzerOptions::getMaxGraphMemory() {
+  if (!MaxGraphMemory.hasValue())
+    MaxGraphMemory = getOptionAsInteger("max-graph-memory", 0);
+  return MaxGraphMemory.getValue();
+}
+
+unsigned AnalyzerOptions::getMaxCachedDeclContexts() {
+  if (!MaxCachedDeclContexts.hasValue())
+    MaxCachedDeclContexts = getOptionAsInteger("max-cached-decl-contexts", 32);
+  return MaxCachedDeclContexts.getValue();
+}
+
+unsigned AnalyzerOptions::getShardCount() {
+  if (!ShardCount.hasValue())
+    ShardCount = getOptionAsInteger("shard-count", 1);
+  return ShardCount.getValue();
+}
+
+unsigned AnalyzerOptions::getShardIndex() {
+  if (!ShardIndex.hasValue())
+    ShardIndex = getOptionAsInteger("shard-index", 0);
+  return ShardIndex.getValue();
+}
+
+StringRef AnalyzerOptions::getAnalysisCacheFile() {
+  return getOptionAsString("analysis-cache-file", "");
+}
+
 bool AnalyzerOptions::shouldSynthesizeBodies() {
   return getBooleanOption("faux-bodies", true);
 }
@@ -17,6 +17,7 @@
 #include "clang/StaticAnalyzer/Core/PathSensitive/CoreEngine.h"
 #include "clang/AST/Expr.h"
 #include "clang/AST/StmtCXX.h"
+#include "clang/StaticAnalyzer/Core/AnalyzerOptions.h"
 #include "clang/StaticAnalyzer/Core/PathSensitive/AnalysisManager.h"
 #include "clang/StaticAnalyzer/Core/PathSensitive/ExprEngine.h"
 #include "llvm/ADT/DenseMap.h"
@@ -30,8 +31,15 @@ STATISTIC(NumSteps,
             "The # of steps executed.");
 STATISTIC(NumReachedMaxSteps,
             "The # of times we reached the max number of steps.");
+STATISTIC(NumReachedMaxGraphMemory,
+            "The # of times we reached the max graph memory.");
+STATISTIC(NumGraphMemoryReclamation,
+            "The # of times nodes were reclaimed more often to stay within "
+            "the max graph memory.");
 STATISTIC(NumPathsExplored,
             "The # of paths explored by the analyzer.");
+STATISTIC(NumBlocksFirstReached,
+            "The # of basic blocks reached for the first time.");
 
 //===----------------------------------------------------------------------===//
 // Worklist classes for exploration of reachable states.
@@ -156,10 +164,126 @@ WorkList* WorkList::makeBFSBlockDFSContents() {
   return new BFSBlockDFSContents();
 }
 
+namespace {
+  class UnexploredFirstStack : public WorkList {
+    FunctionSummariesTy *FunctionSummaries;
+
+    /// The units that entered a basic block not visited yet when they were
+    /// enqueued.
+    SmallVector<WorkListUnit,20> Unexplored;
+
+    /// All other units.
+    SmallVector<WorkListUnit,20> Stack;
+
+    bool entersUnexploredBlock(const WorkListUnit &U) const {
+      Optional<BlockEdge> BE =
+        U.getNode()->getLocation().getAs<BlockEdge>();
+      if (!BE)
+        return false;
+      const Decl *D = BE->getLocationContext()->getDecl();
+      return !FunctionSummaries->isVisitedBasicBlock(
+                                              BE->getDst()->getBlockID(), D);
+    }
+
+  public:
+    explicit UnexploredFirstStack(FunctionSummariesTy *FS)
+      : FunctionSummaries(FS) {}
+
+    virtual bool hasWork() const {
+      return !Unexplored.empty() || !Stack.empty();
+    }
+
+    virtual void enqueue(const WorkListUnit& U) {
+      if (entersUnexploredBlock(U))
+        Unexplored.push_back(U);
+      else
+        Stack.push_back(U);
+    }
+
+    virtual WorkListUnit dequeue() {
+      while (!Unexplored.empty()) {
+        WorkListUnit U = Unexplored.back();
+        Unexplored.pop_back();
+        // Another path may have reached the block in the meantime.
+        if (entersUnexploredBlock(U))
+          return U;
+        Stack.push_back(U);
+      }
+
+      assert(!Stack.empty());
+      WorkListUnit U = Stack.back();
+      Stack.pop_back();
+      return U;
+    }
+
+    virtual bool visitItemsInWorkList(Visitor &V) {
+      for (SmallVectorImpl<WorkListUnit>::iterator
+           I = Unexplored.begin(), E = Unexplored.end(); I != E; ++I) {
+        if (V.visit(*I))
+          return true;
+      }
+      for (SmallVectorImpl<WorkListUnit>::iterator
+           I = Stack.begin(), E = Stack.end(); I != E; ++I) {
+        if (V.visit(*I))
+          return true;
+      }
+      return false;
+    }
+  };
+} // end anonymous namespace
+
+WorkList *WorkList::makeUnexploredFirst(FunctionSummariesTy *FS) {
+  return new UnexploredFirstStack(FS);
+}
+
 //===----------------------------------------------------------------------===//
 // Core analysis engine.
 //===----------------------------------------------------------------------===//
 
+static WorkList *generateWorkList(AnalyzerOptions &Opts,
+                                  FunctionSummariesTy *FS) {
+  switch (Opts.getExplorationStrategy()) {
+    case ESK_NotSet:
+      llvm_unreachable("Exploration strategy is not set.");
+    case ESK_DFS:
+      return WorkList::makeDFS();
+    case ESK_BFS:
+      return WorkList::makeBFS();
+    case ESK_BFSBlockDFSContents:
+      return WorkList::makeBFSBlockDFSContents();
+    case ESK_UnexploredFirst:
+      return WorkList::makeUnexploredFirst(FS);
+  }
+  llvm_unreachable("Unknown exploration strategy.");
+}
+
+CoreEngine::CoreEngine(SubEngine &subengine, FunctionSummariesTy *FS,
+                       AnalyzerOptions &Opts)
+  : SubEng(subengine), G(new ExplodedGraph()),
+    WList(generateWorkList(Opts, FS)),
+    BCounterFactory(G->getAllocator()),
+    FunctionSummaries(FS),
+    MaxGraphMemory(size_t(Opts.getMaxGraphMemory()) * 1024 * 1024) {}
+
+/// The number of steps between two checks of the memory used by the graph.
+/// Computing it walks all of the allocator's slabs.
+static const unsigned GraphMemoryCheckInterval = 1000;
+
+bool CoreEngine::isOverGraphMemoryBudget() {
+  size_t Used = G->getAllocator().getTotalMemory();
+  if (Used >= MaxGraphMemory)
+    return true;
+
+  // Past half of the budget, reclaim nodes at every opportunity, so that new
+  // nodes reuse their memory instead of allocating more.
+  if (Used >= MaxGraphMemory / 2 && G->getNodeReclamationInterval() > 1) {
+    NumGraphMemoryReclamation++;
+    G->enableNodeReclamation(1);
+  }
+
+  return false;
+}
+
 /// ExecuteWorkList - Run the worklist algorithm for a maximum number of steps.
 bool CoreEngine::ExecuteWorkList(const LocationContext *L, unsigned Steps,
                                    ProgramStateRef InitState) {
@@ -199,6 +323,7 @@ bool CoreEngine::ExecuteWorkList(const LocationContext *L, unsigned Steps,
 
   // Check if we have a steps limit
   bool UnlimitedSteps = Steps == 0;
+  unsigned StepsSinceMemoryCheck = 0;
 
   while (WList->hasWork()) {
     if (!UnlimitedSteps) {
@@ -209,6 +334,15 @@ bool CoreEngine::ExecuteWorkList(const LocationContext *L, unsigned Steps,
       --Steps;
     }
 
+    if (MaxGraphMemory &&
+        ++StepsSinceMemoryCheck == GraphMemoryCheckInterval) {
+      StepsSinceMemoryCheck = 0;
+      if (isOverGraphMemoryBudget()) {
+        NumReachedMaxGraphMemory++;
+        break;
+      }
+    }
+
     NumSteps++;
 
     const WorkListUnit& WU = WList->dequeue();
@@ -287,6 +421,9 @@ void CoreEngine::HandleBlockEdge(const BlockEdge &L, ExplodedNode *Pred) {
 
   // Mark this block as visited.
   const LocationContext *LC = Pred->getLocationContext();
+  if (!FunctionSummaries->isVisitedBasicBlock(Blk->getBlockID(),
+                                              LC->getDecl()))
+    ++NumBlocksFirstReached;
   FunctionSummaries->markVisitedBasicBlock(Blk->getBlockID(),
                                            LC->getDecl(),
                                            LC->getCFG()->getNumBlockIDs());
@@ -16,8 +16,10 @@
 #include "clang/StaticAnalyzer/Core/PathSensitive/APSIntType.h"
 #include "clang/StaticAnalyzer/Core/PathSensitive/ProgramState.h"
 #include "clang/StaticAnalyzer/Core/PathSensitive/ProgramStateTrait.h"
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/FoldingSet.h"
-#include "llvm/ADT/ImmutableSet.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/Allocator.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/raw_ostream.h"
 
@@ -55,15 +57,61 @@ public:
 };
 
 
-class RangeTrait : public llvm::ImutContainerInfo<Range> {
+/// RangeList is an immutable, sorted array of disjoint Ranges. Lists are
+/// uniqued by their contents in a RangeListFactory, so two lists holding the
+/// same ranges are always the same object and can be compared by pointer.
+/// The Range objects are allocated directly after the RangeList.
+class RangeList : public llvm::FoldingSetNode {
+  unsigned NumRanges;
+
+  explicit RangeList(unsigned N) : NumRanges(N) {}
+  friend class RangeListFactory;
 public:
-  // When comparing if one Range is less than another, we should compare
-  // the actual APSInt values instead of their pointers.  This keeps the order
-  // consistent (instead of comparing by pointer values) and can potentially
-  // be used to speed up some of the operations in RangeSet.
-  static inline bool isLess(key_type_ref lhs, key_type_ref rhs) {
-    return *lhs.first < *rhs.first || (!(*rhs.first < *lhs.first) &&
-                                       *lhs.second < *rhs.second);
+  typedef const Range *iterator;
+
+  iterator begin() const { return reinterpret_cast<const Range *>(this + 1); }
+  iterator end() const { return begin() + NumRanges; }
+  unsigned size() const { return NumRanges; }
+
+  static void Profile(llvm::FoldingSetNodeID &ID, ArrayRef<Range> Ranges) {
+    ID.AddInteger(Ranges.size());
+    for (ArrayRef<Range>::iterator I = Ranges.begin(), E = Ranges.end();
+         I != E; ++I)
+      I->Profile(ID);
+  }
+
+  void Profile(llvm::FoldingSetNodeID &ID) const {
+    Profile(ID, ArrayRef<Range>(begin(), end()));
+  }
+};
+
+/// RangeListFactory creates and uniques RangeLists. Range sets almost always
+/// hold only a handful of ranges, so a flat array is both smaller and faster
+/// to build than a balanced tree.
+class RangeListFactory {
+  llvm::BumpPtrAllocator Alloc;
+  llvm::FoldingSet<RangeList> Cache;
+public:
+  /// Returns the unique list holding the given ranges, which must be sorted
+  /// and disjoint, or NULL if there are no ranges.
+  const RangeList *getList(ArrayRef<Range> Ranges) {
+    if (Ranges.empty())
+      return 0;
+
+    llvm::FoldingSetNodeID ID;
+    RangeList::Profile(ID, Ranges);
+
+    void *InsertPos;
+    if (RangeList *L = Cache.FindNodeOrInsertPos(ID, InsertPos))
+      return L;
+
+    size_t Size = sizeof(RangeList) + Ranges.size() * sizeof(Range);
+    void *Mem = Alloc.Allocate(Size, llvm::alignOf<RangeList>());
+    RangeList *L = new (Mem) RangeList(Ranges.size());
+    std::uninitialized_copy(Ranges.begin(), Ranges.end(),
+                            const_cast<Range *>(L->begin()));
+    Cache.InsertNode(L, InsertPos);
+    return L;
   }
 };
 
@@ -71,43 +119,44 @@ public:
 ///  there the value of a symbol is overly constrained and there are no
 ///  possible values for that symbol.
 class RangeSet {
-  typedef llvm::ImmutableSet<Range, RangeTrait> PrimRangeSet;
-  PrimRangeSet ranges; // no need to make const, since it is an
-                       // ImmutableSet - this allows default operator=
-                       // to work.
+  const RangeList *ranges; // NULL for the empty set. Lists are uniqued,
+                           // so the default operator= and pointer
+                           // comparison do the right thing.
 public:
-  typedef PrimRangeSet::Factory Factory;
-  typedef PrimRangeSet::iterator iterator;
+  typedef RangeListFactory Factory;
+  typedef RangeList::iterator iterator;
 
-  RangeSet(PrimRangeSet RS) : ranges(RS) {}
+  /// Construct the empty RangeSet.
+  RangeSet() : ranges(0) {}
 
-  iterator begin() const { return ranges.begin(); }
-  iterator end() const { return ranges.end(); }
+  iterator begin() const { return ranges ? ranges->begin() : 0; }
+  iterator end() const { return ranges ? ranges->end() : 0; }
 
-  bool isEmpty() const { return ranges.isEmpty(); }
+  bool isEmpty() const { return !ranges; }
 
   /// Construct a new RangeSet representing '{ [from, to] }'.
   RangeSet(Factory &F, const llvm::APSInt &from, const llvm::APSInt &to)
-    : ranges(F.add(F.getEmptySet(), Range(from, to))) {}
+    : ranges(F.getList(Range(from, to))) {}
 
   /// Profile - Generates a hash profile of this RangeSet for use
   ///  by FoldingSet.
-  void Profile(llvm::FoldingSetNodeID &ID) const { ranges.Profile(ID); }
+  void Profile(llvm::FoldingSetNodeID &ID) const { ID.AddPointer(ranges); }
 
   /// getConcreteValue - If a symbol is contrained to equal a specific integer
   ///  constant then this method returns that value.  Otherwise, it returns
   ///  NULL.
   const llvm::APSInt* getConcreteValue() const {
-    return ranges.isSingleton() ? ranges.begin()->getConcreteValue() : 0;
+    return ranges && ranges->size() == 1 ? begin()->getConcreteValue() : 0;
   }
 
 private:
-  void IntersectInRange(BasicValueFactory &BV, Factory &F,
+  explicit RangeSet(const RangeList *L) : ranges(L) {}
+
+  void IntersectInRange(BasicValueFactory &BV,
                         const llvm::APSInt &Lower,
                         const llvm::APSInt &Upper,
-                        PrimRangeSet &newRanges,
-                        PrimRangeSet::iterator &i,
-                        PrimRangeSet::iterator &e) const {
+                        SmallVectorImpl<Range> &newRanges,
+                        iterator &i, iterator &e) const {
     // There are six cases for each range R in the set:
     //   1. R is entirely before the intersection range.
     //   2. R is entirely after the intersection range.
@@ -126,24 +175,23 @@ private:
 
       if (i->Includes(Lower)) {
         if (i->Includes(Upper)) {
-          newRanges = F.add(newRanges, Range(BV.getValue(Lower),
-                                             BV.getValue(Upper)));
+          newRanges.push_back(Range(BV.getValue(Lower), BV.getValue(Upper)));
           break;
         } else
-          newRanges = F.add(newRanges, Range(BV.getValue(Lower), i->To()));
+          newRanges.push_back(Range(BV.getValue(Lower), i->To()));
       } else {
         if (i->Includes(Upper)) {
-          newRanges = F.add(newRanges, Range(i->From(), BV.getValue(Upper)));
+          newRanges.push_back(Range(i->From(), BV.getValue(Upper)));
           break;
         } else
-          newRanges = F.add(newRanges, *i);
+          newRanges.push_back(*i);
       }
     }
   }
 
   const llvm::APSInt &getMinValue() const {
     assert(!isEmpty());
-    return ranges.begin()->From();
+    return begin()->From();
   }
 
   bool pin(llvm::APSInt &Lower, llvm::APSInt &Upper) const {
@@ -238,22 +286,23 @@ public:
   RangeSet Intersect(BasicValueFactory &BV, Factory &F,
                      llvm::APSInt Lower, llvm::APSInt Upper) const {
     if (!pin(Lower, Upper))
-      return F.getEmptySet();
+      return RangeSet();
 
-    PrimRangeSet newRanges = F.getEmptySet();
+    // The ranges are visited in order, so newRanges stays sorted.
+    SmallVector<Range, 4> newRanges;
 
-    PrimRangeSet::iterator i = begin(), e = end();
+    iterator i = begin(), e = end();
     if (Lower <= Upper)
-      IntersectInRange(BV, F, Lower, Upper, newRanges, i, e);
+      IntersectInRange(BV, Lower, Upper, newRanges, i, e);
     else {
       // The order of the next two statements is important!
       // IntersectInRange() does not reset the iteration state for i and e.
       // Therefore, the lower range most be handled first.
-      IntersectInRange(BV, F, BV.getMinValue(Upper), Upper, newRanges, i, e);
-      IntersectInRange(BV, F, Lower, BV.getMaxValue(Lower), newRanges, i, e);
+      IntersectInRange(BV, BV.getMinValue(Upper), Upper, newRanges, i, e);
+      IntersectInRange(BV, Lower, BV.getMaxValue(Lower), newRanges, i, e);
     }
 
-    return newRanges;
+    return RangeSet(F.getList(newRanges));
   }
 
   void print(raw_ostream &os) const {
@@ -213,6 +213,15 @@ public:
     return asImmutableMap().getRootWithoutRetain();
   }
 
+  /// Return the internal tree as a Store, replaced with the identical tree
+  /// that was returned before, if any.
+  ///
+  /// Stores that are returned this way can be compared by pointer, which
+  /// lets identical program states be uniqued.
+  Store asCanonicalStore() const {
+    return Factory->getCanonicalTree(Root);
+  }
+
   void dump(raw_ostream &OS, const char *nl) const {
    for (iterator I = begin(), E = end(); I != E; ++I) {
      const ClusterBindings &Cluster = I.getData();
@@ -345,6 +354,17 @@ private:
   /// To disable all small-struct-dependent behavior, set the option to "0".
   unsigned SmallStructLimit;
 
+  /// Whether the stores created by this manager are canonicalized, so that
+  /// stores with the same bindings are represented by the same tree.
+  ///
+  /// The bindings of each cluster are always canonicalized; this extends it
+  /// to the map from base regions to clusters. Program states that only
+  /// differed by the identity of their store trees can then be uniqued, and
+  /// the paths that reach them merged.
+  ///
+  /// This is controlled by 'region-store-canonicalize-bindings' option.
+  bool CanonicalizeBindings;
+
   /// \brief A helper used to populate the work list with the given set of
   /// regions.
   void populateWorkList(invalidateRegionsWorker &W,
@@ -355,14 +375,22 @@ public:
   RegionStoreManager(ProgramStateManager& mgr, const RegionStoreFeatures &f)
     : StoreManager(mgr), Features(f),
       RBFactory(mgr.getAllocator()), CBFactory(mgr.getAllocator()),
-      SmallStructLimit(0) {
+      SmallStructLimit(0), CanonicalizeBindings(false) {
     if (SubEngine *Eng = StateMgr.getOwningEngine()) {
       AnalyzerOptions &Options = Eng->getAnalysisManager().options;
       SmallStructLimit =
         Options.getOptionAsInteger("region-store-small-struct-limit", 2);
+      CanonicalizeBindings =
+        Options.getBooleanOption("region-store-canonicalize-bindings", false);
     }
   }
 
+  /// Return the given bindings as a store, canonicalized if requested.
+  StoreRef makeStoreRef(RegionBindingsConstRef B) {
+    return StoreRef(CanonicalizeBindings ? B.asCanonicalStore() : B.asStore(),
+                    *this);
+  }
+
 
   /// setImplicitDefaultValue - Set the default binding for the provided
   ///  MemRegion to the value implicitly defined for compound literals when
@@ -411,7 +439,7 @@ public:
 public: // Part of public interface to class.
 
   virtual StoreRef Bind(Store store, Loc LV, SVal V) {
-    return StoreRef(bind(getRegionBindings(store), LV, V).asStore(), *this);
+    return makeStoreRef(bind(getRegionBindings(store), LV, V));
   }
 
   RegionBindingsRef bind(RegionBindingsConstRef B, Loc LV, SVal V);
@@ -432,7 +460,7 @@ public: // Part of public interface to class.
       B = B.addBinding(Key, V);
     }
 
-    return StoreRef(B.asImmutableMap().getRootWithoutRetain(), *this);
+    return makeStoreRef(B);
   }
 
   /// Attempt to extract the fields of \p LCV and bind them to the struct region
@@ -1200,7 +1228,7 @@ RegionStoreManager::invalidateRegions(Store store,
     break;
   }
 
-  return StoreRef(B.asStore(), *this);
+  return makeStoreRef(B);
 }
 
 //===----------------------------------------------------------------------===//
@@ -1822,7 +1850,7 @@ NonLoc RegionStoreManager::createLazyBinding(RegionBindingsConstRef B,
         getExistingLazyBinding(svalBuilder, B, R, false))
     return *V;
 
-  return svalBuilder.makeLazyCompoundVal(StoreRef(B.asStore(), *this), R);
+  return svalBuilder.makeLazyCompoundVal(makeStoreRef(B), R);
 }
 
 static bool isRecordEmpty(const RecordDecl *RD) {
@@ -1881,10 +1909,7 @@ bool RegionStoreManager::includedInBindings(Store store,
 StoreRef RegionStoreManager::killBinding(Store ST, Loc L) {
   if (Optional<loc::MemRegionVal> LV = L.getAs<loc::MemRegionVal>())
     if (const MemRegion* R = LV->getRegion())
-      return StoreRef(getRegionBindings(ST).removeBinding(R)
-                                           .asImmutableMap()
-                                           .getRootWithoutRetain(),
-                      *this);
+      return makeStoreRef(getRegionBindings(ST).removeBinding(R));
 
   return StoreRef(ST, *this);
 }
@@ -1969,7 +1994,7 @@ RegionStoreManager::bindArray(RegionBindingsConstRef B,
     const StringRegion *S = cast<StringRegion>(MRV->getRegion());
 
     // Treat the string as a lazy compound value.
-    StoreRef store(B.asStore(), *this);
+    StoreRef store = makeStoreRef(B);
     nonloc::LazyCompoundVal LCV = svalBuilder.makeLazyCompoundVal(store, S)
         .castAs<nonloc::LazyCompoundVal>();
     return bindAggregate(B, R, LCV);
@@ -2346,7 +2371,7 @@ StoreRef RegionStoreManager::removeDeadBindings(Store store,
     }
   }
 
-  return StoreRef(B.asStore(), *this);
+  return makeStoreRef(B);
 }
 
 //===----------------------------------------------------------------------===//
@@ -25,6 +25,9 @@
 #include "clang/Analysis/CallGraph.h"
 #include "clang/Basic/FileManager.h"
 #include "clang/Basic/SourceManager.h"
+#include "clang/Basic/TargetInfo.h"
+#include "clang/Frontend/FrontendDiagnostic.h"
+#include "clang/Lex/Lexer.h"
 #include "clang/Lex/Preprocessor.h"
 #include "clang/StaticAnalyzer/Checkers/LocalCheckers.h"
 #include "clang/StaticAnalyzer/Core/AnalyzerOptions.h"
@@ -38,14 +41,22 @@
 #include "llvm/ADT/DepthFirstIterator.h"
 #include "llvm/ADT/OwningPtr.h"
 #include "llvm/ADT/PostOrderIterator.h"
+#include "llvm/ADT/SCCIterator.h"
 #include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/Statistic.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Program.h"
 #include "llvm/Support/Timer.h"
 #include "llvm/Support/raw_ostream.h"
+#include <algorithm>
+#include <map>
 #include <queue>
+#include <set>
 
 using namespace clang;
 using namespace ento;
@@ -61,6 +72,14 @@ STATISTIC(NumBlocksInAnalyzedFunctions,
                       "The # of basic blocks in the analyzed functions.");
 STATISTIC(PercentReachableBlocks, "The % of reachable basic blocks.");
 STATISTIC(MaxCFGSize, "The maximum number of basic blocks in a function.");
+STATISTIC(NumFunctionsInOtherShards,
+                      "The # of functions at top level left to other shards.");
+STATISTIC(NumFunctionsCachedClean,
+                      "The # of functions at top level skipped because they "
+                      "had no reports when they were last analyzed.");
+STATISTIC(NumDeclContextsDiscarded,
+                      "The # of analysis contexts discarded between top level "
+                      "functions.");
 
 //===----------------------------------------------------------------------===//
 // Special PathDiagnosticConsumers.
@@ -170,6 +189,9 @@ class AnalysisConsumer : public ASTConsumer,
   AnalysisMode RecVisitorMode;
   /// Bug Reporter to use while recursively visiting Decls.
   BugReporter *RecVisitorBR;
+  /// The number of functions, methods and blocks the recursive visitor
+  /// handled so far.
+  unsigned RecVisitorNumCodeDecls;
 
 public:
   ASTContext *Ctx;
@@ -201,12 +223,17 @@ public:
   /// translation unit.
   FunctionSummariesTy FunctionSummaries;
 
+  /// Set when the path-sensitive analysis of the function being analyzed
+  /// produced any reports.
+  bool FoundPathSensitiveReports;
+
   AnalysisConsumer(const Preprocessor& pp,
                    const std::string& outdir,
                    AnalyzerOptionsRef opts,
                    ArrayRef<std::string> plugins)
-    : RecVisitorMode(0), RecVisitorBR(0),
-      Ctx(0), PP(pp), OutDir(outdir), Opts(opts), Plugins(plugins) {
+    : RecVisitorMode(0), RecVisitorBR(0), RecVisitorNumCodeDecls(0),
+      Ctx(0), PP(pp), OutDir(outdir), Opts(opts), Plugins(plugins),
+      FoundPathSensitiveReports(false) {
     DigestAnalyzerOptions();
     if (Opts->PrintStats) {
       llvm::EnableStatistics();
@@ -330,6 +357,17 @@ public:
   /// use it to define the order in which the functions should be visited.
   void HandleDeclsCallGraph(const unsigned LocalTUDeclsSize);
 
+  /// \brief Compute the keys under which the results of analyzing the
+  /// functions in the call graph are recorded in the analysis cache file.
+  ///
+  /// The key of a function changes when its source text, the key of any of
+  /// its callees, the text of the main file outside of function bodies, any
+  /// included file, or the analyzer configuration changes. Functions for
+  /// which no key can be computed are left out of \p Keys.
+  void
+  computeAnalysisCacheKeys(CallGraph &CG,
+                           llvm::DenseMap<const Decl *, std::string> &Keys);
+
   /// \brief Run analyzes(syntax or path sensitive) on the given function.
   /// \param Mode - determines if we are requesting syntax only or path
   /// sensitive only analysis.
@@ -368,7 +406,7 @@ public:
     if (FD->isThisDeclarationADefinition() &&
         !FD->isDependentContext()) {
       assert(RecVisitorMode == AM_Syntax || Mgr->shouldInlineCall() == false);
-      HandleCode(FD, RecVisitorMode);
+      HandleCode(FD, getRecVisitorModeForCode());
     }
     return true;
   }
@@ -376,7 +414,7 @@ public:
   bool VisitObjCMethodDecl(ObjCMethodDecl *MD) {
     if (MD->isThisDeclarationADefinition()) {
       assert(RecVisitorMode == AM_Syntax || Mgr->shouldInlineCall() == false);
-      HandleCode(MD, RecVisitorMode);
+      HandleCode(MD, getRecVisitorModeForCode());
     }
     return true;
   }
@@ -384,7 +422,7 @@ public:
   bool VisitBlockDecl(BlockDecl *BD) {
     if (BD->hasBody()) {
       assert(RecVisitorMode == AM_Syntax || Mgr->shouldInlineCall() == false);
-      HandleCode(BD, RecVisitorMode);
+      HandleCode(BD, getRecVisitorModeForCode());
     }
     return true;
   }
@@ -392,6 +430,21 @@ public:
 private:
   void storeTopLevelDecls(DeclGroupRef DG);
 
+  /// \brief Get the mode in which the recursive visitor analyzes the next
+  /// function, method or block.
+  ///
+  /// When the analysis is split into shards and path-sensitive analysis is
+  /// done by the visitor (that is, without inlining), the functions are dealt
+  /// out to the shards round-robin, in the order in which they are visited.
+  AnalysisMode getRecVisitorModeForCode() {
+    AnalysisMode Mode = RecVisitorMode;
+    unsigned ShardCount = Mgr->options.getShardCount();
+    if ((Mode & AM_Path) && ShardCount > 1 &&
+        RecVisitorNumCodeDecls++ % ShardCount != Mgr->options.getShardIndex())
+      Mode &= ~AM_Path;
+    return Mode;
+  }
+
   /// \brief Check if we should skip (not analyze) the given function.
   AnalysisMode getModeForDecl(Decl *D, AnalysisMode Mode);
 
@@ -462,6 +515,320 @@ AnalysisConsumer::getInliningModeForFunction(const Decl *D,
   return ExprEngine::Inline_Regular;
 }
 
+//===----------------------------------------------------------------------===//
+// Analysis cache.
+//===----------------------------------------------------------------------===//
+
+static void addToHash(llvm::MD5 &Hash, StringRef Str) {
+  Hash.update(Str);
+  // Separate consecutive strings, so that "ab" + "c" and "a" + "bc" differ.
+  Hash.update(StringRef("", 1));
+}
+
+static std::string getHashString(llvm::MD5 &Hash) {
+  llvm::MD5::MD5Result Result;
+  Hash.final(Result);
+  SmallString<32> Str;
+  llvm::MD5::stringifyResult(Result, Str);
+  return Str.str();
+}
+
+/// Returns the offsets in their file of the first and one past the last
+/// character of the given range, or false if the range does not lie within a
+/// single file.
+static bool getFileOffsets(const SourceManager &SM, const LangOptions &LO,
+                           SourceRange R, FileID &FID,
+                           unsigned &Begin, unsigned &End) {
+  SourceLocation B = SM.getExpansionLoc(R.getBegin());
+  SourceLocation E = SM.getExpansionLoc(R.getEnd());
+  if (B.isInvalid() || E.isInvalid())
+    return false;
+
+  std::pair<FileID, unsigned> BInfo = SM.getDecomposedLoc(B);
+  std::pair<FileID, unsigned> EInfo = SM.getDecomposedLoc(E);
+  if (BInfo.first != EInfo.first || BInfo.second > EInfo.second)
+    return false;
+
+  FID = BInfo.first;
+  Begin = BInfo.second;
+  End = EInfo.second + Lexer::MeasureTokenLength(E, SM, LO);
+  return true;
+}
+
+/// Returns the source text of the given declaration, including its body, or
+/// an empty string if it cannot be determined.
+static StringRef getDeclText(const SourceManager &SM, const LangOptions &LO,
+                             const Decl *D) {
+  FileID FID;
+  unsigned Begin, End;
+  if (!getFileOffsets(SM, LO, D->getSourceRange(), FID, Begin, End))
+    return StringRef();
+
+  bool Invalid = false;
+  StringRef Buffer = SM.getBufferData(FID, &Invalid);
+  if (Invalid || End > Buffer.size())
+    return StringRef();
+  return Buffer.slice(Begin, End);
+}
+
+/// Looks up the functions with the given cache keys. Returns false if one of
+/// them is not part of the translation unit anymore.
+static bool lookupCacheKeys(const std::vector<std::string> &Keys,
+                            const llvm::StringMap<const Decl *> &DeclsByKey,
+                            SmallVectorImpl<const Decl *> &Decls) {
+  for (unsigned i = 0, e = Keys.size(); i != e; ++i) {
+    llvm::StringMap<const Decl *>::const_iterator Pos
+      = DeclsByKey.find(Keys[i]);
+    if (Pos == DeclsByKey.end())
+      return false;
+    Decls.push_back(Pos->second);
+  }
+  return true;
+}
+
+/// Gets the cache keys of the given functions, in a deterministic order.
+/// Returns false if one of them has no key.
+static bool getCacheKeys(const SetOfConstDecls &Decls,
+                       const llvm::DenseMap<const Decl *, std::string> &Keys,
+                       std::vector<std::string> &Result) {
+  for (SetOfConstDecls::const_iterator I = Decls.begin(), E = Decls.end();
+       I != E; ++I) {
+    llvm::DenseMap<const Decl *, std::string>::const_iterator Pos
+      = Keys.find(*I);
+    if (Pos == Keys.end() || Pos->second.empty())
+      return false;
+    Result.push_back(Pos->second);
+  }
+  std::sort(Result.begin(), Result.end());
+  return true;
+}
+
+/// Maps the cache key of each function that had no reports to the cache keys
+/// of the functions that were inlined while analyzing it.
+typedef std::map<std::string, std::vector<std::string> > AnalysisCache;
+
+/// Reads an analysis cache file. Each line holds the key of a function
+/// followed by the keys of the functions inlined into it, separated by
+/// spaces.
+static void readAnalysisCache(StringRef Path, AnalysisCache &Entries) {
+  OwningPtr<llvm::MemoryBuffer> Buffer;
+  if (llvm::MemoryBuffer::getFile(Path, Buffer))
+    return;
+
+  SmallVector<StringRef, 64> Lines;
+  Buffer->getBuffer().split(Lines, "\n", -1, /*KeepEmpty=*/false);
+  for (unsigned i = 0, e = Lines.size(); i != e; ++i) {
+    SmallVector<StringRef, 8> Keys;
+    Lines[i].split(Keys, " ", -1, /*KeepEmpty=*/false);
+    if (Keys.empty())
+      continue;
+    std::vector<std::string> &Inlined = Entries[Keys[0].trim()];
+    Inlined.clear();
+    for (unsigned j = 1, je = Keys.size(); j != je; ++j)
+      Inlined.push_back(Keys[j].trim());
+  }
+}
+
+/// Updates an analysis cache file with the results of this run: the
+/// functions in \p Dirty had reports and are removed, and the functions in
+/// \p Clean are added. The entries for the other functions, which may have
+/// been added by other runs since the file was read, are kept.
+static void writeAnalysisCache(DiagnosticsEngine &Diags, StringRef Path,
+                               const AnalysisCache &Clean,
+                               const std::set<std::string> &Dirty) {
+  AnalysisCache Entries;
+  readAnalysisCache(Path, Entries);
+  for (std::set<std::string>::const_iterator I = Dirty.begin(),
+                                             E = Dirty.end(); I != E; ++I)
+    Entries.erase(*I);
+  for (AnalysisCache::const_iterator I = Clean.begin(), E = Clean.end();
+       I != E; ++I)
+    Entries[I->first] = I->second;
+
+  // Write to a temporary file that is then moved into place, so that
+  // concurrent runs never read a partially written file.
+  SmallString<128> TempPath(Path);
+  TempPath += "-%%%%%%%%";
+  int FD;
+  if (llvm::error_code EC =
+          llvm::sys::fs::createUniqueFile(TempPath.str(), FD, TempPath)) {
+    Diags.Report(diag::warn_analysis_cache_file_write) << Path << EC.message();
+    return;
+  }
+
+  {
+    llvm::raw_fd_ostream OS(FD, /*shouldClose=*/true);
+    for (AnalysisCache::const_iterator I = Entries.begin(), E = Entries.end();
+         I != E; ++I) {
+      OS << I->first;
+      for (unsigned i = 0, e = I->second.size(); i != e; ++i)
+        OS << ' ' << I->second[i];
+      OS << '\n';
+    }
+  }
+
+  if (llvm::error_code EC = llvm::sys::fs::rename(TempPath.str(), Path)) {
+    Diags.Report(diag::warn_analysis_cache_file_write) << Path << EC.message();
+    bool Existed;
+    llvm::sys::fs::remove(TempPath.str(), Existed);
+  }
+}
+
+void AnalysisConsumer::computeAnalysisCacheKeys(
+    CallGraph &CG, llvm::DenseMap<const Decl *, std::string> &Keys) {
+  SourceManager &SM = Ctx->getSourceManager();
+  const LangOptions &LO = PP.getLangOpts();
+
+  // Everything that every function's key depends on: the configuration...
+  llvm::MD5 ContextHash;
+  std::vector<std::string> Config;
+  for (AnalyzerOptions::ConfigTable::const_iterator I = Opts->Config.begin(),
+                                                    E = Opts->Config.end();
+       I != E; ++I) {
+    // Where the cache lives does not affect the analysis.
+    if (I->getKey() == "analysis-cache-file")
+      continue;
+    Config.push_back((I->getKey() + "=" + I->getValue()).str());
+  }
+  std::sort(Config.begin(), Config.end());
+  for (unsigned i = 0, e = Config.size(); i != e; ++i)
+    addToHash(ContextHash, Config[i]);
+
+  for (unsigned i = 0, e = Opts->CheckersControlList.size(); i != e; ++i) {
+    addToHash(ContextHash, Opts->CheckersControlList[i].first);
+    addToHash(ContextHash, Opts->CheckersControlList[i].second ? "+" : "-");
+  }
+
+  std::string Flags;
+  llvm::raw_string_ostream FlagsOS(Flags);
+  FlagsOS << Opts->AnalysisStoreOpt << ' ' << Opts->AnalysisConstraintsOpt
+          << ' ' << Opts->AnalysisPurgeOpt << ' ' << Opts->maxBlockVisitOnPath
+          << ' ' << Opts->AnalyzeAll << ' ' << Opts->AnalyzeNestedBlocks
+          << ' ' << Opts->eagerlyAssumeBinOpBifurcation
+          << ' ' << Opts->UnoptimizedCFG << ' ' << Opts->NoRetryExhausted
+          << ' ' << Opts->InlineMaxStackDepth << ' ' << Opts->InliningMode
+          << ' ' << Opts->AnalyzeSpecificFunction;
+  addToHash(ContextHash, FlagsOS.str());
+
+  // ...the target and the language options, as reflected by the predefined
+  // macros...
+  addToHash(ContextHash, Ctx->getTargetInfo().getTriple().str());
+  addToHash(ContextHash, PP.getPredefines());
+
+  // ...the included files...
+  FileID MainFID = SM.getMainFileID();
+  const FileEntry *MainFile = SM.getFileEntryForID(MainFID);
+  std::vector<std::string> Files;
+  for (SourceManager::fileinfo_iterator I = SM.fileinfo_begin(),
+                                        E = SM.fileinfo_end(); I != E; ++I) {
+    const FileEntry *FE = I->first;
+    if (FE == MainFile)
+      continue;
+    std::string File;
+    llvm::raw_string_ostream FileOS(File);
+    FileOS << FE->getName() << ' ' << FE->getSize() << ' '
+           << (uint64_t)FE->getModificationTime();
+    Files.push_back(FileOS.str());
+  }
+  std::sort(Files.begin(), Files.end());
+  for (unsigned i = 0, e = Files.size(); i != e; ++i)
+    addToHash(ContextHash, Files[i]);
+
+  // ...and the main file, except for the bodies of the functions, which only
+  // affect the keys of the functions and of their callers.
+  std::vector<std::pair<unsigned, unsigned> > Bodies;
+  for (CallGraph::iterator I = CG.begin(), E = CG.end(); I != E; ++I) {
+    const Decl *D = I->first;
+    if (!D || !D->getBody())
+      continue;
+    FileID FID;
+    unsigned Begin, End;
+    if (getFileOffsets(SM, LO, D->getBody()->getSourceRange(), FID, Begin, End)
+        && FID == MainFID)
+      Bodies.push_back(std::make_pair(Begin, End));
+  }
+  std::sort(Bodies.begin(), Bodies.end());
+
+  StringRef MainBuffer = SM.getBufferData(MainFID);
+  unsigned Pos = 0;
+  for (unsigned i = 0, e = Bodies.size(); i != e; ++i) {
+    // Nested bodies (of blocks, for instance) are skipped with their parent.
+    if (Bodies[i].first < Pos)
+      continue;
+    addToHash(ContextHash, MainBuffer.slice(Pos, Bodies[i].first));
+    Pos = Bodies[i].second;
+  }
+  addToHash(ContextHash, MainBuffer.substr(Pos));
+  std::string Context = getHashString(ContextHash);
+
+  // Visit the strongly connected components of the call graph, callees
+  // first. The functions of a component share the keys of their callees.
+  std::map<std::string, unsigned> KeyUses;
+  for (llvm::scc_iterator<CallGraph *> I = llvm::scc_begin(&CG);
+       !I.isAtEnd(); ++I) {
+    const std::vector<CallGraphNode *> &SCC = *I;
+    llvm::SmallPtrSet<const Decl *, 4> Members;
+    for (unsigned i = 0, e = SCC.size(); i != e; ++i)
+      Members.insert(SCC[i]->getDecl());
+
+    llvm::MD5 SCCHash;
+    addToHash(SCCHash, Context);
+    bool Cacheable = true;
+    for (unsigned i = 0, e = SCC.size(); i != e && Cacheable; ++i) {
+      const Decl *D = SCC[i]->getDecl();
+      if (!D) {
+        // The root of the call graph.
+        Cacheable = false;
+        break;
+      }
+
+      StringRef Text = getDeclText(SM, LO, D);
+      if (Text.empty()) {
+        Cacheable = false;
+        break;
+      }
+      addToHash(SCCHash, Text);
+
+      for (CallGraphNode::iterator CI = SCC[i]->begin(), CE = SCC[i]->end();
+           CI != CE; ++CI) {
+        const Decl *Callee = (*CI)->getDecl();
+        if (Members.count(Callee))
+          continue;
+        llvm::DenseMap<const Decl *, std::string>::iterator KeyPos
+          = Keys.find(Callee);
+        if (KeyPos == Keys.end()) {
+          Cacheable = false;
+          break;
+        }
+        addToHash(SCCHash, KeyPos->second);
+      }
+    }
+    if (!Cacheable)
+      continue;
+
+    std::string SCCKey = getHashString(SCCHash);
+    for (unsigned i = 0, e = SCC.size(); i != e; ++i) {
+      const Decl *D = SCC[i]->getDecl();
+      llvm::MD5 Hash;
+      addToHash(Hash, SCCKey);
+      addToHash(Hash, getDeclText(SM, LO, D));
+      std::string Key = getHashString(Hash);
+      ++KeyUses[Key];
+      Keys[D] = Key;
+    }
+  }
+
+  // Functions with the same text, such as the instantiations of a template,
+  // get the same key. Their results cannot be told apart, so do not cache
+  // them.
+  for (llvm::DenseMap<const Decl *, std::string>::iterator I = Keys.begin(),
+                                                           E = Keys.end();
+       I != E; ++I) {
+    if (KeyUses[I->second] > 1)
+      I->second.clear();
+  }
+}
+
 void AnalysisConsumer::HandleDeclsCallGraph(const unsigned LocalTUDeclsSize) {
   // Build the Call Graph by adding all the top level declarations to the graph.
   // Note: CallGraph can trigger deserialization of more items from a pch
@@ -472,6 +839,36 @@ void AnalysisConsumer::HandleDeclsCallGraph(const unsigned LocalTUDeclsSize) {
     CG.addToCallGraph(LocalTUDecls[i]);
   }
 
+  // When the analysis is split into shards, the functions are dealt out to
+  // the shards round-robin, in the (deterministic) order of the traversal
+  // below, as the recursive visitor does. A function inlined while analyzing
+  // a function of one shard may thus still be analyzed as a top level
+  // function by another shard.
+  unsigned ShardCount = Mgr->options.getShardCount();
+  unsigned ShardIndex = Mgr->options.getShardIndex();
+  unsigned NumDealtFunctions = 0;
+
+  // When an analysis cache file is given, skip the functions that had no
+  // reports the last time they were analyzed and have not changed since.
+  // The functions that were inlined while analyzing them are recorded as
+  // well, so that they are skipped as top level functions exactly as they
+  // would be if the function was analyzed.
+  StringRef CacheFile = Mgr->options.getAnalysisCacheFile();
+  llvm::DenseMap<const Decl *, std::string> CacheKeys;
+  llvm::StringMap<const Decl *> DeclsByCacheKey;
+  AnalysisCache CachedCleanFunctions;
+  AnalysisCache CleanFunctions;
+  std::set<std::string> DirtyFunctions;
+  if (!CacheFile.empty()) {
+    computeAnalysisCacheKeys(CG, CacheKeys);
+    for (llvm::DenseMap<const Decl *, std::string>::iterator
+           I = CacheKeys.begin(), E = CacheKeys.end(); I != E; ++I) {
+      if (!I->second.empty())
+        DeclsByCacheKey[I->second] = I->first;
+    }
+    readAnalysisCache(CacheFile, CachedCleanFunctions);
+  }
+
   // Walk over all of the call graph nodes in topological order, so that we
   // analyze parents before the children. Skip the functions inlined into
   // the previously processed functions. Use external Visited set to identify
@@ -492,16 +889,52 @@ void AnalysisConsumer::HandleDeclsCallGraph(const unsigned LocalTUDeclsSize) {
     if (!D)
       continue;
 
+    // Skip the functions that belong to another shard.
+    if (ShardCount > 1 && NumDealtFunctions++ % ShardCount != ShardIndex) {
+      NumFunctionsInOtherShards++;
+      continue;
+    }
+
     // Skip the functions which have been processed already or previously
     // inlined.
     if (shouldSkipFunction(D, Visited, VisitedAsTopLevel))
       continue;
 
+    StringRef Key;
+    if (!CacheFile.empty()) {
+      llvm::DenseMap<const Decl *, std::string>::iterator KeyPos
+        = CacheKeys.find(D);
+      if (KeyPos != CacheKeys.end())
+        Key = KeyPos->second;
+    }
+    if (!Key.empty()) {
+      AnalysisCache::iterator Cached = CachedCleanFunctions.find(Key);
+      SmallVector<const Decl *, 8> Inlined;
+      if (Cached != CachedCleanFunctions.end() &&
+          lookupCacheKeys(Cached->second, DeclsByCacheKey, Inlined)) {
+        NumFunctionsCachedClean++;
+        CleanFunctions[Key] = Cached->second;
+        for (unsigned i = 0, e = Inlined.size(); i != e; ++i)
+          Visited.insert(Inlined[i]);
+        VisitedAsTopLevel.insert(D);
+        continue;
+      }
+    }
+
     // Analyze the function.
     SetOfConstDecls VisitedCallees;
 
+    FoundPathSensitiveReports = false;
     HandleCode(D, AM_Path, getInliningModeForFunction(D, Visited),
                (Mgr->options.InliningMode == All ? 0 : &VisitedCallees));
+    if (!Key.empty()) {
+      std::vector<std::string> InlinedKeys;
+      if (!FoundPathSensitiveReports &&
+          getCacheKeys(VisitedCallees, CacheKeys, InlinedKeys))
+        CleanFunctions[Key] = InlinedKeys;
+      else
+        DirtyFunctions.insert(Key);
+    }
 
     // Add the visited callees to the global visited set.
     for (SetOfConstDecls::iterator I = VisitedCallees.begin(),
@@ -510,6 +943,10 @@ void AnalysisConsumer::HandleDeclsCallGraph(const unsigned LocalTUDeclsSize) {
     }
     VisitedAsTopLevel.insert(D);
   }
+
+  if (!CacheFile.empty())
+    writeAnalysisCache(PP.getDiagnostics(), CacheFile, CleanFunctions,
+                       DirtyFunctions);
 }
 
 void AnalysisConsumer::HandleTranslationUnit(ASTContext &C) {
@@ -524,15 +961,22 @@ void AnalysisConsumer::HandleTranslationUnit(ASTContext &C) {
     // Introduce a scope to destroy BR before Mgr.
     BugReporter BR(*Mgr);
     TranslationUnitDecl *TU = C.getTranslationUnitDecl();
-    checkerMgr->runCheckersOnASTDecl(TU, *Mgr, BR);
+
+    // When the analysis is split into shards, only the first shard runs the
+    // checks that are not path-sensitive.
+    bool IsFirstShard = Mgr->options.getShardIndex() == 0;
+
+    if (IsFirstShard)
+      checkerMgr->runCheckersOnASTDecl(TU, *Mgr, BR);
 
     // Run the AST-only checks using the order in which functions are defined.
     // If inlining is not turned on, use the simplest function order for path
     // sensitive analyzes as well.
-    RecVisitorMode = AM_Syntax;
+    RecVisitorMode = IsFirstShard ? AM_Syntax : AM_None;
     if (!Mgr->shouldInlineCall())
       RecVisitorMode |= AM_Path;
     RecVisitorBR = &BR;
+    RecVisitorNumCodeDecls = 0;
 
     // Process all the top level declarations.
     //
@@ -541,15 +985,18 @@ void AnalysisConsumer::HandleTranslationUnit(ASTContext &C) {
     // random access.  By doing so, we automatically compensate for iterators
     // possibly being invalidated, although this is a bit slower.
     const unsigned LocalTUDeclsSize = LocalTUDecls.size();
-    for (unsigned i = 0 ; i < LocalTUDeclsSize ; ++i) {
-      TraverseDecl(LocalTUDecls[i]);
+    if (RecVisitorMode != AM_None) {
+      for (unsigned i = 0 ; i < LocalTUDeclsSize ; ++i) {
+        TraverseDecl(LocalTUDecls[i]);
+      }
     }
 
     if (Mgr->shouldInlineCall())
       HandleDeclsCallGraph(LocalTUDeclsSize);
 
     // After all decls handled, run checkers on the entire TranslationUnit.
-    checkerMgr->runCheckersOnEndOfTranslationUnit(TU, *Mgr, BR);
+    if (IsFirstShard)
+      checkerMgr->runCheckersOnEndOfTranslationUnit(TU, *Mgr, BR);
 
     RecVisitorBR = 0;
   }
@@ -622,7 +1069,7 @@ void AnalysisConsumer::HandleCode(Decl *D, AnalysisMode Mode,
   }
 
   // Clear the AnalysisManager of old AnalysisDeclContexts.
-  Mgr->ClearContexts();
+  NumDeclContextsDiscarded += Mgr->ClearContexts();
   BugReporter BR(*Mgr);
 
   if (Mode & AM_Syntax)
@@ -667,6 +1114,10 @@ void AnalysisConsumer::ActionExprEngine(Decl *D, bool ObjCGCEnabled,
   // created BugReporter.
   ExplodedNode::SetAuditor(0);
 
+  BugReporter &BR = Eng.getBugReporter();
+  if (BR.EQClasses_begin() != BR.EQClasses_end())
+    FoundPathSensitiveReports = true;
+
   // Visualize the exploded graph.
   if (Mgr->options.visualizeExplodedGraphWithGraphViz)
     Eng.ViewGraph(Mgr->options.TrimGraph);
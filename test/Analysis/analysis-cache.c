@@ -0,0 +1,50 @@
+// RUN: rm -f %t.cache
+// RUN: %clang_cc1 -analyze -analyzer-checker=core -analyzer-display-progress -analyzer-config analysis-cache-file=%t.cache -verify %s 2>&1 | FileCheck -check-prefix=FIRST %s
+// RUN: %clang_cc1 -analyze -analyzer-checker=core -analyzer-display-progress -analyzer-config analysis-cache-file=%t.cache -verify %s 2>&1 | FileCheck -check-prefix=SECOND %s
+//
+// The location of the cache file is not part of the keys.
+// RUN: cp %t.cache %t.moved
+// RUN: %clang_cc1 -analyze -analyzer-checker=core -analyzer-display-progress -analyzer-config analysis-cache-file=%t.moved -verify %s 2>&1 | FileCheck -check-prefix=SECOND %s
+//
+// Runs with a different configuration add their entries to the file without
+// dropping those of the other runs.
+// RUN: %clang_cc1 -analyze -analyzer-checker=core -analyzer-display-progress -analyzer-config analysis-cache-file=%t.cache -DOTHER -verify %s 2>&1 | FileCheck -check-prefix=FIRST %s
+// RUN: %clang_cc1 -analyze -analyzer-checker=core -analyzer-display-progress -analyzer-config analysis-cache-file=%t.cache -verify %s 2>&1 | FileCheck -check-prefix=SECOND %s
+//
+// RUN: %clang_cc1 -analyze -analyzer-checker=core -analyzer-config analysis-cache-file=%t.nonexistent/cache %s 2>&1 | FileCheck -check-prefix=WRITE-ERROR %s
+
+// The functions that had no reports are not analyzed again as long as they
+// do not change. The functions with reports are, so that their reports are
+// still emitted.
+
+int clean(int x) {
+  return x + 1;
+}
+
+void dirty(int *p) {
+  if (p)
+    return;
+  *p = 0; // expected-warning{{Dereference of null pointer}}
+}
+
+// The functions inlined into a function that is not analyzed again are not
+// analyzed as top level functions either, just as if it had been analyzed.
+
+int inlined(int x) {
+  return x * 2;
+}
+
+int caller(int x) {
+  return inlined(x);
+}
+
+// FIRST-DAG: ANALYZE (Path, {{.*}}analysis-cache.c clean
+// FIRST-DAG: ANALYZE (Path, {{.*}}analysis-cache.c dirty
+// FIRST-DAG: ANALYZE (Path, {{.*}}analysis-cache.c caller
+
+// FIRST-NOT: ANALYZE (Path, {{.*}}analysis-cache.c inlined
+// SECOND-NOT: ANALYZE (Path, {{.*}}analysis-cache.c clean
+// SECOND-NOT: ANALYZE (Path, {{.*}}analysis-cache.c caller
+// SECOND-NOT: ANALYZE (Path, {{.*}}analysis-cache.c inlined
+
+// WRITE-ERROR: warning: unable to write analysis cache file '{{.*}}nonexistent/cache'
@@ -5,18 +5,25 @@ void bar() {}
 void foo() { bar(); }
 
 // CHECK: [config]
+// CHECK-NEXT: analysis-cache-file =
 // CHECK-NEXT: cfg-conditional-static-initializers = true
 // CHECK-NEXT: cfg-temporary-dtors = false
+// CHECK-NEXT: exploration-strategy = dfs
 // CHECK-NEXT: faux-bodies = true
 // CHECK-NEXT: graph-trim-interval = 1000
 // CHECK-NEXT: ipa = dynamic-bifurcate
 // CHECK-NEXT: ipa-always-inline-size = 3
 // CHECK-NEXT: leak-diagnostics-reference-allocation = false
+// CHECK-NEXT: max-cached-decl-contexts = 32
+// CHECK-NEXT: max-graph-memory = 0
 // CHECK-NEXT: max-inlinable-size = 50
 // CHECK-NEXT: max-nodes = 150000
 // CHECK-NEXT: max-times-inline-large = 32
 // CHECK-NEXT: mode = deep
+// CHECK-NEXT: region-store-canonicalize-bindings = false
 // CHECK-NEXT: region-store-small-struct-limit = 2
+// CHECK-NEXT: shard-count = 1
+// CHECK-NEXT: shard-index = 0
 // CHECK-NEXT: [stats]
-// CHECK-NEXT: num-entries = 12
+// CHECK-NEXT: num-entries = 19
 
@@ -0,0 +1,20 @@
+// RUN: %clang_cc1 -analyze -analyzer-checker=core -analyzer-config ipa=none -analyzer-config shard-count=2 -analyzer-config shard-index=0 %s 2> %t.0
+// RUN: %clang_cc1 -analyze -analyzer-checker=core -analyzer-config ipa=none -analyzer-config shard-count=2 -analyzer-config shard-index=1 %s 2> %t.1
+// RUN: FileCheck -check-prefix=SHARD0 --input-file=%t.0 %s
+// RUN: FileCheck -check-prefix=SHARD1 --input-file=%t.1 %s
+
+// Without inlining, the functions are analyzed in the order in which they are
+// defined, and dealt out to the shards round-robin.
+
+void first(void) {
+  int *p = 0;
+  *p = 1; // SHARD0: analyzer-shards-noinline.c:[[@LINE]]:{{[0-9]+}}: warning: Dereference of null pointer
+}
+
+void second(void) {
+  int *p = 0;
+  *p = 2; // SHARD1: analyzer-shards-noinline.c:[[@LINE]]:{{[0-9]+}}: warning: Dereference of null pointer
+}
+
+// SHARD0-NOT: warning:
+// SHARD1-NOT: warning:
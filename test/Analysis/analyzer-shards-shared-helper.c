@@ -0,0 +1,36 @@
+// RUN: %clang_cc1 -analyze -analyzer-checker=core -analyzer-config shard-count=2 -analyzer-config shard-index=0 %s 2> %t.0
+// RUN: %clang_cc1 -analyze -analyzer-checker=core -analyzer-config shard-count=2 -analyzer-config shard-index=1 %s 2> %t.1
+// RUN: FileCheck -check-prefix=HALF --input-file=%t.0 %s
+// RUN: FileCheck -check-prefix=HALF --input-file=%t.1 %s
+// RUN: cat %t.0 %t.1 | FileCheck %s
+
+// All the functions call the same helper, so they form a single connected
+// component of the call graph. They are still spread over both shards.
+
+int helper(int x) {
+  return x + 1;
+}
+
+void a(void) {
+  int *p = 0;
+  *p = helper(1); // CHECK-DAG: analyzer-shards-shared-helper.c:[[@LINE]]:{{[0-9]+}}: warning: Dereference of null pointer
+}
+
+void b(void) {
+  int *p = 0;
+  *p = helper(2); // CHECK-DAG: analyzer-shards-shared-helper.c:[[@LINE]]:{{[0-9]+}}: warning: Dereference of null pointer
+}
+
+void c(void) {
+  int *p = 0;
+  *p = helper(3); // CHECK-DAG: analyzer-shards-shared-helper.c:[[@LINE]]:{{[0-9]+}}: warning: Dereference of null pointer
+}
+
+void d(void) {
+  int *p = 0;
+  *p = helper(4); // CHECK-DAG: analyzer-shards-shared-helper.c:[[@LINE]]:{{[0-9]+}}: warning: Dereference of null pointer
+}
+
+// HALF: warning: Dereference of null pointer
+// HALF: warning: Dereference of null pointer
+// HALF-NOT: warning:
@@ -0,0 +1,32 @@
+// RUN: %clang_cc1 -analyze -analyzer-checker=core -analyzer-config shard-count=2 -analyzer-config shard-index=0 %s 2> %t.0
+// RUN: %clang_cc1 -analyze -analyzer-checker=core -analyzer-config shard-count=2 -analyzer-config shard-index=1 %s 2> %t.1
+// RUN: FileCheck -check-prefix=ONE --input-file=%t.0 %s
+// RUN: FileCheck -check-prefix=ONE --input-file=%t.1 %s
+// RUN: cat %t.0 %t.1 | FileCheck %s
+// RUN: not %clang_cc1 -analyze -analyzer-checker=core -analyzer-config shard-count=2 -analyzer-config shard-index=2 %s 2>&1 | FileCheck -check-prefix=BAD-INDEX %s
+// RUN: not %clang_cc1 -analyze -analyzer-checker=core -analyzer-config shard-index=1 %s 2>&1 | FileCheck -check-prefix=BAD-INDEX-ONE %s
+// RUN: not %clang_cc1 -analyze -analyzer-checker=core -analyzer-config shard-count=0 %s 2>&1 | FileCheck -check-prefix=BAD-COUNT %s
+
+// The functions are dealt out to the shards round-robin. The shard that gets
+// 'caller' finds the null dereference in 'callee' by inlining it. The shard
+// that gets 'callee' as a top level function finds nothing in it.
+
+void callee(int *p) {
+  *p = 1; // CHECK-DAG: analyzer-shards.c:[[@LINE]]:{{[0-9]+}}: warning: Dereference of null pointer
+}
+
+void caller(void) {
+  callee(0);
+}
+
+void alone(void) {
+  int *p = 0;
+  *p = 2; // CHECK-DAG: analyzer-shards.c:[[@LINE]]:{{[0-9]+}}: warning: Dereference of null pointer
+}
+
+// ONE: warning: Dereference of null pointer
+// ONE-NOT: warning:
+
+// BAD-INDEX: error: analyzer-config option 'shard-index' must be less than 'shard-count' (2), not '2'
+// BAD-INDEX-ONE: error: analyzer-config option 'shard-index' must be less than 'shard-count' (1), not '1'
+// BAD-COUNT: error: analyzer-config option 'shard-count' must be a positive integer, not '0'
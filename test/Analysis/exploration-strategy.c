@@ -0,0 +1,27 @@
+// RUN: %clang_cc1 -analyze -analyzer-checker=core -analyzer-config exploration-strategy=dfs -verify %s
+// RUN: %clang_cc1 -analyze -analyzer-checker=core -analyzer-config exploration-strategy=bfs -verify %s
+// RUN: %clang_cc1 -analyze -analyzer-checker=core -analyzer-config exploration-strategy=bfs-block-dfs-contents -verify %s
+// RUN: %clang_cc1 -analyze -analyzer-checker=core -analyzer-config exploration-strategy=unexplored-first -verify %s
+
+int loopThenBranch(int n, int flag) {
+  int sum = 0;
+  for (int i = 0; i < n; ++i)
+    sum += i;
+
+  int *p = 0;
+  if (flag)
+    return *p; // expected-warning{{Dereference of null pointer}}
+  return sum;
+}
+
+void branches(int a, int b) {
+  int x = 0;
+  if (a)
+    x = 1;
+  if (b)
+    x = 2;
+  if (x == 2) {
+    int *q = 0;
+    *q = a; // expected-warning{{Dereference of null pointer}}
+  }
+}
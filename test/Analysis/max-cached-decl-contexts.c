@@ -0,0 +1,39 @@
+// REQUIRES: asserts
+// RUN: %clang_cc1 -analyze -analyzer-checker=core -verify %s
+// RUN: %clang_cc1 -analyze -analyzer-checker=core -analyzer-config max-cached-decl-contexts=0 -verify %s
+// RUN: %clang_cc1 -analyze -analyzer-checker=core -analyzer-config max-cached-decl-contexts=1 -verify %s
+// RUN: %clang_cc1 -analyze -analyzer-checker=core -analyzer-config max-cached-decl-contexts=1 -analyzer-stats %s 2>&1 | FileCheck -check-prefix=EVICT %s
+// RUN: %clang_cc1 -analyze -analyzer-checker=core -analyzer-stats %s 2>&1 | FileCheck -check-prefix=KEEP %s
+
+// The contexts of the inlined functions are discarded between the top level
+// functions when the cache is small, and rebuilt when they are inlined again.
+// The reports are the same either way.
+
+static int *identity(int *p) {
+  return p;
+}
+
+static int twice(int x) {
+  return 2 * x;
+}
+
+void first(void) {
+  int *p = identity(0);
+  *p = twice(1); // expected-warning{{Dereference of null pointer}}
+}
+
+void second(int x) {
+  int *p = identity(&x);
+  *p = twice(2); // no-warning
+}
+
+void third(void) {
+  int *p = identity(0);
+  *p = twice(3); // expected-warning{{Dereference of null pointer}}
+}
+
+// EVICT: ... Statistics Collected ...
+// EVICT: {{[0-9]+}} AnalysisConsumer{{ +}}- The # of analysis contexts discarded between top level functions.
+
+// KEEP: ... Statistics Collected ...
+// KEEP-NOT: The # of analysis contexts discarded
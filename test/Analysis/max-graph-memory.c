@@ -0,0 +1,27 @@
+// REQUIRES: asserts
+// RUN: %clang_cc1 -analyze -analyzer-checker=core -analyzer-stats -analyzer-config max-graph-memory=1 %s 2>&1 | FileCheck -check-prefix=LIMIT %s
+// RUN: %clang_cc1 -analyze -analyzer-checker=core -analyzer-stats %s 2>&1 | FileCheck -check-prefix=NOLIMIT %s
+
+// Every branch doubles the number of distinct states, so exploring this
+// function allocates far more than a megabyte of nodes and states.
+
+extern int flags[16];
+
+#define BRANCH(n) if (flags[n]) x = x * 2 + 1; else x = x * 3;
+
+int explode(int x) {
+  BRANCH(0) BRANCH(1) BRANCH(2) BRANCH(3)
+  BRANCH(4) BRANCH(5) BRANCH(6) BRANCH(7)
+  BRANCH(8) BRANCH(9) BRANCH(10) BRANCH(11)
+  BRANCH(12) BRANCH(13) BRANCH(14) BRANCH(15)
+  return x;
+}
+
+// Past half of the budget, nodes are reclaimed at every opportunity; once it
+// is used up, exploration stops.
+// LIMIT: ... Statistics Collected ...
+// LIMIT: 1 CoreEngine{{ +}}- The # of times nodes were reclaimed more often to stay within the max graph memory.
+// LIMIT: 1 CoreEngine{{ +}}- The # of times we reached the max graph memory.
+
+// NOLIMIT: ... Statistics Collected ...
+// NOLIMIT-NOT: max graph memory
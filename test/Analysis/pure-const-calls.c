@@ -0,0 +1,32 @@
+// RUN: %clang_cc1 -analyze -analyzer-checker=core,debug.ExprInspection -verify %s
+
+void clang_analyzer_eval(int);
+
+int global;
+
+int pureFunction(int) __attribute__((pure));
+int pureFunctionReadingPointer(int *) __attribute__((pure));
+int constFunction(int) __attribute__((const));
+int unknownFunction(int *);
+
+void testGlobalsArePreserved() {
+  global = 1;
+  pureFunction(0);
+  clang_analyzer_eval(global == 1); // expected-warning{{TRUE}}
+  constFunction(0);
+  clang_analyzer_eval(global == 1); // expected-warning{{TRUE}}
+  unknownFunction(0);
+  clang_analyzer_eval(global == 1); // expected-warning{{UNKNOWN}}
+}
+
+void testArgumentsArePreserved() {
+  int x = 1;
+  pureFunctionReadingPointer(&x);
+  clang_analyzer_eval(x == 1); // expected-warning{{TRUE}}
+  unknownFunction(&x);
+  clang_analyzer_eval(x == 1); // expected-warning{{UNKNOWN}}
+}
+
+void testReturnValueIsUnknown() {
+  clang_analyzer_eval(pureFunction(0) == 0); // expected-warning{{UNKNOWN}}
+}
@@ -0,0 +1,22 @@
+// REQUIRES: asserts
+// RUN: %clang_cc1 -analyze -analyzer-checker=core -analyzer-stats %s 2>&1 | FileCheck -check-prefix=SEPARATE %s
+// RUN: %clang_cc1 -analyze -analyzer-checker=core -analyzer-stats -analyzer-config region-store-canonicalize-bindings=true %s 2>&1 | FileCheck -check-prefix=MERGED %s
+
+// Both branches of each 'if' bind the same values, and the constraints on
+// the conditions die with them. The stores at each join point hold the same
+// bindings, but are different trees unless they are canonicalized. Only
+// canonical stores let the states be uniqued and the paths merge.
+
+int join(int c1, int c2, int c3) {
+  int x, y;
+  if (c1) { x = 1; y = 2; } else { y = 2; x = 1; }
+  if (c2) { x = 3; y = 4; } else { y = 4; x = 3; }
+  if (c3) { x = 5; y = 6; } else { y = 6; x = 5; }
+  return x + y;
+}
+
+// SEPARATE: ... Statistics Collected ...
+// SEPARATE: 8 CoreEngine{{ +}}- The # of paths explored by the analyzer.
+
+// MERGED: ... Statistics Collected ...
+// MERGED: 1 CoreEngine{{ +}}- The # of paths explored by the analyzer.
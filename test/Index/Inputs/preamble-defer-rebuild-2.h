@@ -0,0 +1,2 @@
+int from_header(int);
+int added_to_header(int);
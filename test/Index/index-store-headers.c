@@ -0,0 +1,36 @@
+#include "index-store-header.h"
+
+int VAR;
+
+int use(void) {
+  return VAR;
+}
+
+// RUN: rm -rf %t && mkdir -p %t
+// RUN: echo '#define VAR first' > %t/index-store-header.h
+// RUN: echo 'int in_header;' >> %t/index-store-header.h
+// RUN: c-index-test -index-store-record %t/store %s -I%t | FileCheck %s -check-prefix=INDEXED
+// RUN: c-index-test -index-store-find %t/store c:@first | FileCheck %s -check-prefix=FIRST
+// RUN: c-index-test -index-store-find %t/store c:@in_header | FileCheck %s -check-prefix=IN-HEADER
+
+// Changing only the header re-indexes the unchanged main file, and removes
+// the unit's record of the header, which no longer has any occurrences.
+// RUN: echo '#define VAR second_var' > %t/index-store-header.h
+// RUN: c-index-test -index-store-record %t/store %s -I%t | FileCheck %s -check-prefix=INDEXED
+// RUN: c-index-test -index-store-find %t/store c:@second_var > %t/after.txt
+// RUN: echo END >> %t/after.txt
+// RUN: c-index-test -index-store-find %t/store c:@first >> %t/after.txt
+// RUN: c-index-test -index-store-find %t/store c:@in_header >> %t/after.txt
+// RUN: FileCheck %s -check-prefix=AFTER < %t/after.txt
+
+// INDEXED: [index-store]: indexed
+
+// FIRST:      [declaration]: {{.*}}index-store-headers.c:3:5
+// FIRST-NEXT: [reference]: {{.*}}index-store-headers.c:6:10
+
+// IN-HEADER: [declaration]: {{.*}}index-store-header.h:2:5
+
+// AFTER:      [declaration]: {{.*}}index-store-headers.c:3:5
+// AFTER-NEXT: [reference]: {{.*}}index-store-headers.c:6:10
+// AFTER-NEXT: END
+// AFTER-NOT: [
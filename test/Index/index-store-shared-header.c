@@ -0,0 +1,24 @@
+#include "index-store-shared.h"
+
+int main_var;
+
+// Index the same file as two units, one of which compiles the header's
+// declaration out. Indexing the second unit must not remove the record the
+// first one wrote for the header.
+// RUN: rm -rf %t && mkdir -p %t
+// RUN: echo '#ifdef WITH_FOO' > %t/index-store-shared.h
+// RUN: echo 'int foo_in_header;' >> %t/index-store-shared.h
+// RUN: echo '#endif' >> %t/index-store-shared.h
+// RUN: c-index-test -index-store-record %t/store %s -I%t -DWITH_FOO | FileCheck %s -check-prefix=INDEXED
+// RUN: c-index-test -index-store-record %t/store %s -I%t | FileCheck %s -check-prefix=INDEXED
+// RUN: c-index-test -index-store-find %t/store c:@foo_in_header | FileCheck %s -check-prefix=FOO
+
+// Both units record the main file; each occurrence is reported once.
+// RUN: c-index-test -index-store-find %t/store c:@main_var | FileCheck %s -check-prefix=MAIN
+
+// INDEXED: [index-store]: indexed
+
+// FOO: [declaration]: {{.*}}index-store-shared.h:2:5
+
+// MAIN:     [declaration]: {{.*}}index-store-shared-header.c:3:5
+// MAIN-NOT: [
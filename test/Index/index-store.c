@@ -0,0 +1,25 @@
+int global;
+
+int use_global(void) {
+  return global;
+}
+
+int use_again(void) {
+  return global + use_global();
+}
+
+// RUN: rm -rf %t
+// RUN: c-index-test -index-store-record %t %s | FileCheck %s -check-prefix=FIRST
+// RUN: c-index-test -index-store-record %t %s | FileCheck %s -check-prefix=SECOND
+// RUN: c-index-test -index-store-find %t c:@global | FileCheck %s -check-prefix=GLOBAL
+// RUN: c-index-test -index-store-find %t c:@F@use_global | FileCheck %s -check-prefix=FUNC
+
+// FIRST: [index-store]: indexed
+// SECOND: [index-store]: up-to-date
+
+// GLOBAL:      [declaration]: {{.*}}index-store.c:1:5
+// GLOBAL-NEXT: [reference]: {{.*}}index-store.c:4:10
+// GLOBAL-NEXT: [reference]: {{.*}}index-store.c:8:10
+
+// FUNC:      [declaration]: {{.*}}index-store.c:3:5
+// FUNC-NEXT: [reference]: {{.*}}index-store.c:8:19
@@ -0,0 +1,11 @@
+// RUN: c-index-test -test-load-source-memory-usage none %s 2>&1 | FileCheck %s
+
+int add(int a, int b) {
+  return a + b;
+}
+
+// CHECK: Memory usage:
+// CHECK: ASTContext: expressions, declarations, and types : {{[1-9][0-9]*}} bytes
+// CHECK: ASTContext: statements and expressions (part of AST) : {{[1-9][0-9]*}} bytes
+// CHECK: ASTContext: type source info (part of AST) : {{[1-9][0-9]*}} bytes
+// CHECK: TOTAL =
@@ -0,0 +1,35 @@
+// RUN: env CINDEXTEST_EDITING=1 CINDEXTEST_DEFER_PREAMBLE_REBUILD=1 \
+// RUN:     CINDEXTEST_REMAP_AFTER_TRIAL=1 \
+// RUN:     c-index-test -test-load-source-reparse 3 local \
+// RUN:     "-remap-file=%S/Inputs/preamble-defer-rebuild.h;%S/Inputs/preamble-defer-rebuild-2.h" \
+// RUN:     -I %S/Inputs %s 2>&1 | FileCheck %s
+// RUN: env CINDEXTEST_EDITING=1 CINDEXTEST_REMAP_AFTER_TRIAL=1 \
+// RUN:     c-index-test -test-load-source-reparse 3 local \
+// RUN:     "-remap-file=%S/Inputs/preamble-defer-rebuild.h;%S/Inputs/preamble-defer-rebuild-2.h" \
+// RUN:     -I %S/Inputs %s 2>&1 | FileCheck -check-prefix=CHECK-REBUILD %s
+
+// A header that changed on disk, rather than through an unsaved file, makes
+// the preamble's source locations invalid, so the preamble is rebuilt.
+// RUN: rm -rf %t.dir
+// RUN: mkdir -p %t.dir
+// RUN: cp %S/Inputs/preamble-defer-rebuild.h %t.dir/
+// RUN: env CINDEXTEST_EDITING=1 CINDEXTEST_DEFER_PREAMBLE_REBUILD=1 \
+// RUN:     CINDEXTEST_REMAP_AFTER_TRIAL=1 CINDEXTEST_SAVE_REMAPPED_FILES=1 \
+// RUN:     c-index-test -test-load-source-reparse 3 local \
+// RUN:     "-remap-file=%t.dir/preamble-defer-rebuild.h;%S/Inputs/preamble-defer-rebuild-2.h" \
+// RUN:     -I %t.dir %s 2>&1 | FileCheck -check-prefix=CHECK-DISK %s
+
+#include "preamble-defer-rebuild.h"
+
+int main(void) {
+  return from_header(0);
+}
+
+// CHECK: Using stale precompiled preamble
+// CHECK-NOT: error:
+// CHECK: FunctionDecl=main:24:5 (Definition)
+// CHECK-REBUILD-NOT: Using stale precompiled preamble
+// CHECK-REBUILD: FunctionDecl=main:24:5 (Definition)
+// CHECK-DISK-NOT: Using stale precompiled preamble
+// CHECK-DISK-NOT: error:
+// CHECK-DISK: FunctionDecl=main:24:5 (Definition)
@@ -0,0 +1,21 @@
+// RUN: %clang_cc1 -fsyntax-only -print-stats %s 2>&1 | FileCheck %s
+// RUN: %clang_cc1 -x c++ -fsyntax-only -print-stats -DCREATE_ONLY %s 2>&1 | FileCheck %s
+
+#ifdef CREATE_ONLY
+// DeclRefExpr and ImplicitCastExpr are the only expressions here. Both are
+// allocated by their Create() functions rather than by Stmt::operator new.
+int y;
+int x = y;
+#else
+int add(int a, int b) {
+  int c = a + b;
+  return c * 2;
+}
+#endif
+
+// CHECK: *** AST Context Memory:
+// CHECK-NEXT: {{[1-9][0-9]*}} bytes allocated for the AST
+// CHECK-NEXT: {{[1-9][0-9]*}} bytes in types
+// CHECK-NEXT: {{[1-9][0-9]*}} bytes in type source info
+// CHECK-NEXT: {{[1-9][0-9]*}} bytes in statements and expressions
+// CHECK-NEXT: {{[0-9]+}} bytes allocated for side tables
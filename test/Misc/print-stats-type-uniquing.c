@@ -0,0 +1,16 @@
+// RUN: %clang_cc1 -fsyntax-only -print-stats %s 2>&1 | FileCheck %s
+
+int *p;
+int *q;
+int a[4];
+int b[4];
+void f(int);
+void g(int);
+
+// CHECK: *** AST Context Stats:
+// CHECK: {{[0-9]+}} Pointer types
+// CHECK-NEXT: {{[1-9][0-9]*}}/{{[1-9][0-9]*}} lookups found an existing type
+// CHECK: {{[0-9]+}} ConstantArray types
+// CHECK-NEXT: {{[1-9][0-9]*}}/{{[1-9][0-9]*}} lookups found an existing type
+// CHECK: {{[0-9]+}} FunctionProto types
+// CHECK-NEXT: {{[1-9][0-9]*}}/{{[1-9][0-9]*}} lookups found an existing type
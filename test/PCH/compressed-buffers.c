@@ -0,0 +1,30 @@
+// REQUIRES: zlib
+
+// Test with compressed buffers in the pch.
+// RUN: %clang_cc1 -emit-pch -fcompress-pch-buffers -DFROM_CMDLINE=42 -o %t %s
+// RUN: llvm-bcanalyzer -dump %t | FileCheck %s -check-prefix=COMPRESSED
+// RUN: %clang_cc1 -include-pch %t -DFROM_CMDLINE=42 -fsyntax-only -verify %s
+
+// Buffers are only compressed on request.
+// RUN: %clang_cc1 -emit-pch -DFROM_CMDLINE=42 -o %t.uncompressed %s
+// RUN: llvm-bcanalyzer -dump %t.uncompressed | FileCheck %s -check-prefix=UNCOMPRESSED
+
+// The predefines buffer is stored compressed.
+// COMPRESSED: <SM_SLOC_BUFFER_BLOB_COMPRESSED
+// UNCOMPRESSED-NOT: <SM_SLOC_BUFFER_BLOB_COMPRESSED
+// UNCOMPRESSED: <SM_SLOC_BUFFER_BLOB
+// UNCOMPRESSED-NOT: <SM_SLOC_BUFFER_BLOB_COMPRESSED
+
+#ifndef HEADER
+#define HEADER
+
+#define MAKE_HAPPY(X) X##Happy
+int MAKE_HAPPY(Very) = FROM_CMDLINE;
+
+#else
+
+int *ip = &VeryHappy;
+int array[FROM_CMDLINE == 42 ? 1 : -1];
+float f = VeryHappy; // expected-no-diagnostics
+
+#endif
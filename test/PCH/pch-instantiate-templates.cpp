@@ -0,0 +1,37 @@
+// Test without PCH
+// RUN: %clang_cc1 -include %s -emit-llvm -o - %s | FileCheck %s
+
+// Test with PCH, with and without instantiating templates in the PCH
+// RUN: %clang_cc1 -x c++-header -emit-pch -o %t %s
+// RUN: %clang_cc1 -include-pch %t -emit-llvm -o - %s | FileCheck %s
+// RUN: %clang_cc1 -x c++-header -emit-pch -fpch-instantiate-templates -o %t.inst %s
+// RUN: %clang_cc1 -include-pch %t.inst -emit-llvm -o - %s | FileCheck %s
+
+// Only the instantiation of the template that is not defined in the PCH is
+// left pending for the translation unit; twice<int> is not instantiated again.
+// RUN: llvm-bcanalyzer -dump %t | FileCheck -check-prefix=PENDING-BOTH %s
+// RUN: llvm-bcanalyzer -dump %t.inst | FileCheck -check-prefix=PENDING-ONE %s
+
+#ifndef HEADER
+#define HEADER
+
+template <typename T> T twice(T t) { return t + t; }
+
+// Declared in the PCH, defined by the translation unit.
+template <typename T> T thrice(T t);
+
+inline int twice_int(int i) { return twice(i); }
+inline int thrice_int(int i) { return thrice(i); }
+
+#else
+
+template <typename T> T thrice(T t) { return t + t + t; }
+
+// CHECK-DAG: define linkonce_odr i32 @_Z5twiceIiET_S0_(
+// CHECK-DAG: define linkonce_odr i32 @_Z6thriceIiET_S0_(
+int f(int i) { return twice_int(i) + twice(i) + thrice_int(i); }
+
+#endif
+
+// PENDING-BOTH: <PENDING_IMPLICIT_INSTANTIATIONS op0={{[0-9]+}} op1={{[0-9]+}} op2={{[0-9]+}} op3={{[0-9]+}}/>
+// PENDING-ONE: <PENDING_IMPLICIT_INSTANTIATIONS op0={{[0-9]+}} op1={{[0-9]+}}/>
@@ -0,0 +1,37 @@
+// RUN: %clang_cc1 -std=c++11 -fsyntax-only -verify %s
+// RUN: %clang_cc1 -std=c++11 -fsyntax-only -verify %s -fconstexpr-check-memoization
+// RUN: %clang_cc1 -std=c++11 -fsyntax-only -verify %s -DDEPTH_LIMIT -fconstexpr-depth 31
+// RUN: %clang_cc1 -std=c++11 -fsyntax-only -verify %s -DDEPTH_LIMIT -fconstexpr-depth 31 -fconstexpr-check-memoization
+// RUN: %clang_cc1 -std=c++11 -fsyntax-only -print-stats %s 2>&1 | FileCheck %s --check-prefix=STATS
+// expected-no-diagnostics
+
+// STATS: {{[1-9][0-9]*}}/{{[1-9][0-9]*}} constexpr call results reused
+
+#ifndef DEPTH_LIMIT
+
+// Without memoization of the calls, evaluating fib(80) would take an
+// exponential number of steps, far beyond the step limit.
+constexpr unsigned long long fib(unsigned n) {
+  return n < 2 ? n : fib(n - 1) + fib(n - 2);
+}
+constexpr unsigned long long fib80 = fib(80);
+static_assert(fib80 == 23416728348467685ULL, "");
+
+constexpr double half(double d) { return d / 2; }
+static_assert(half(half(8.0)) == 2.0, "");
+
+// Calls with reference arguments depend on more than the argument values.
+constexpr int get(const int &n) { return n; }
+constexpr int one = 1, two = 2;
+static_assert(get(one) == 1 && get(two) == 2, "");
+
+#else
+
+// leaf(3) is memoized, then called again beyond the depth limit. The memoized
+// result is used; checking it cannot re-evaluate the call, and does not make
+// the evaluation fail.
+constexpr int leaf(int n) { return n + 1; }
+constexpr int nest(int n, int k) { return k == 0 ? leaf(n) : nest(n, k - 1); }
+static_assert(leaf(3) + nest(3, 30) == 8, "");
+
+#endif
@@ -74,6 +74,8 @@ static unsigned getDefaultParsingOptions() {
     options |= CXTranslationUnit_SkipFunctionBodies;
   if (getenv("CINDEXTEST_COMPLETION_BRIEF_COMMENTS"))
     options |= CXTranslationUnit_IncludeBriefCommentsInCodeCompletion;
+  if (getenv("CINDEXTEST_DEFER_PREAMBLE_REBUILD"))
+    options |= CXTranslationUnit_DeferPreambleRebuild;
   
   return options;
 }
@@ -192,6 +194,24 @@ int parse_remapped_files(int argc, const char **argv, int start_arg,
   return 0;
 }
 
+/* Write the contents of the remapped files over the files they remap, to
+ * simulate saving them. */
+static int save_remapped_files(struct CXUnsavedFile *unsaved_files,
+                               int num_unsaved_files) {
+  int i;
+  for (i = 0; i != num_unsaved_files; ++i) {
+    FILE *file = fopen(unsaved_files[i].Filename, "wb");
+    if (!file) {
+      fprintf(stderr, "error: cannot write file %s\n",
+              unsaved_files[i].Filename);
+      return -1;
+    }
+    fwrite(unsaved_files[i].Contents, 1, unsaved_files[i].Length, file);
+    fclose(file);
+  }
+  return 0;
+}
+
 static const char *parse_comments_schema(int argc, const char **argv) {
   const char *CommentsSchemaArg = "-comments-xml-schema=";
   const char *CommentSchemaFile = NULL;
@@ -940,7 +960,10 @@ void PrintMemoryUsage(CXTranslationUnit TU) {
   for (i = 0 ; i != usage.numEntries; ++i) {
     const char *name = clang_getTUResourceUsageName(usage.entries[i].kind);
     unsigned long amount = usage.entries[i].amount;
-    total += amount;
+    /* The AST breakdown entries are already counted in the AST entry. */
+    if (usage.entries[i].kind < CXTUResourceUsage_AST_BREAKDOWN_BEGIN ||
+        usage.entries[i].kind > CXTUResourceUsage_AST_BREAKDOWN_END)
+      total += amount;
     fprintf(stderr, "  %s : %ld bytes (%f MBytes)\n", name, amount,
             ((double) amount)/(1024*1024));
   }
@@ -1418,6 +1441,8 @@ int perform_test_reparse_source(int argc, const char **argv, int trials,
   int result;
   int trial;
   int remap_after_trial = 0;
+  int save_remapped = 0;
+  int use_unsaved;
   char *endptr = 0;
   
   Idx = clang_createIndex(/* excludeDeclsFromPCH */
@@ -1449,11 +1474,24 @@ int perform_test_reparse_source(int argc, const char **argv, int trials,
     remap_after_trial =
         strtol(getenv("CINDEXTEST_REMAP_AFTER_TRIAL"), &endptr, 10);
   }
+  /* Rather than passing the remapped files as unsaved files, write them to
+   * disk before that trial. */
+  if (getenv("CINDEXTEST_SAVE_REMAPPED_FILES"))
+    save_remapped = 1;
 
   for (trial = 0; trial < trials; ++trial) {
+    if (save_remapped && trial == remap_after_trial &&
+        save_remapped_files(unsaved_files, num_unsaved_files)) {
+      clang_disposeTranslationUnit(TU);
+      free_remapped_files(unsaved_files, num_unsaved_files);
+      clang_disposeIndex(Idx);
+      return -1;
+    }
+
+    use_unsaved = trial >= remap_after_trial && !save_remapped;
     if (clang_reparseTranslationUnit(TU,
-                             trial >= remap_after_trial ? num_unsaved_files : 0,
-                             trial >= remap_after_trial ? unsaved_files : 0,
+                                     use_unsaved ? num_unsaved_files : 0,
+                                     use_unsaved ? unsaved_files : 0,
                                      clang_defaultReparseOptions(TU))) {
       fprintf(stderr, "Unable to reparse translation unit!\n");
       clang_disposeTranslationUnit(TU);
@@ -1465,6 +1503,9 @@ int perform_test_reparse_source(int argc, const char **argv, int trials,
     if (checkForErrors(TU) != 0)
       return -1;
   }
+
+  if (clang_isPreambleStale(TU))
+    fprintf(stderr, "Using stale precompiled preamble\n");
   
   result = perform_test_load(Idx, TU, filter, NULL, Visitor, PV, NULL);
 
@@ -3102,6 +3143,160 @@ static int index_compile_db(int argc, const char **argv) {
   return errorCode;
 }
 
+static int index_compile_db_batch(int argc, const char **argv) {
+  const char *check_prefix;
+  CXIndex Idx;
+  CXIndexAction idxAction;
+  IndexData index_data;
+  CXCompilationDatabase db;
+  CXCompileCommands CCmds;
+  CXCompilationDatabase_Error ec;
+  char *tmp;
+  char *buildDir;
+  unsigned len;
+  int errorCode = 0;
+
+  check_prefix = 0;
+  if (argc > 0) {
+    if (strstr(argv[0], "-check-prefix=") == argv[0]) {
+      check_prefix = argv[0] + strlen("-check-prefix=");
+      ++argv;
+      --argc;
+    }
+  }
+
+  if (argc == 0) {
+    fprintf(stderr, "no compilation database\n");
+    return -1;
+  }
+
+  len = strlen(argv[0]);
+  tmp = (char *) malloc(len+1);
+  memcpy(tmp, argv[0], len+1);
+  buildDir = dirname(tmp);
+
+  db = clang_CompilationDatabase_fromDirectory(buildDir, &ec);
+  if (!db || ec != CXCompilationDatabase_NoError) {
+    printf("database loading failed with error code %d.\n", ec);
+    clang_CompilationDatabase_dispose(db);
+    free(tmp);
+    return -1;
+  }
+
+  if (chdir(buildDir) != 0) {
+    printf("Could not chdir to %s\n", buildDir);
+    clang_CompilationDatabase_dispose(db);
+    free(tmp);
+    return -1;
+  }
+
+  CCmds = clang_CompilationDatabase_getAllCompileCommands(db);
+  if (!CCmds) {
+    printf("compilation db is empty\n");
+    clang_CompilationDatabase_dispose(db);
+    free(tmp);
+    return -1;
+  }
+
+  if (!(Idx = clang_createIndex(/* excludeDeclsFromPCH */ 1,
+                                /* displayDiagnostics=*/1))) {
+    fprintf(stderr, "Could not create Index\n");
+    errorCode = 1;
+    goto cdb_end;
+  }
+  idxAction = clang_IndexAction_create(Idx);
+
+  index_data.check_prefix = check_prefix;
+  index_data.first_check_printed = 0;
+  index_data.fail_for_error = 0;
+  index_data.abort = 0;
+  index_data.main_filename = "";
+  index_data.importedASTs = 0;
+
+  if (clang_indexCompileCommandsSerially(idxAction, &index_data,
+                                         &IndexCB, sizeof(IndexCB),
+                                         getIndexOptions(), CCmds,
+                                         getDefaultParsingOptions()))
+    errorCode = -1;
+  if (index_data.fail_for_error)
+    errorCode = -1;
+
+  clang_IndexAction_dispose(idxAction);
+  clang_disposeIndex(Idx);
+
+cdb_end:
+  clang_CompileCommands_dispose(CCmds);
+  clang_CompilationDatabase_dispose(db);
+  free(tmp);
+  return errorCode;
+}
+
+static int index_store_record(int argc, const char **argv) {
+  CXIndex Idx;
+  CXIndexAction idxAction;
+  CXIndexStore store;
+  CXIndexStoreResult result;
+
+  if (argc < 2) {
+    fprintf(stderr, "no index store or compiler arguments\n");
+    return -1;
+  }
+
+  if (!(store = clang_IndexStore_create(argv[0]))) {
+    fprintf(stderr, "Could not open index store '%s'\n", argv[0]);
+    return 1;
+  }
+  if (!(Idx = clang_createIndex(/* excludeDeclsFromPCH */ 1,
+                                /* displayDiagnostics=*/1))) {
+    fprintf(stderr, "Could not create Index\n");
+    clang_IndexStore_dispose(store);
+    return 1;
+  }
+  idxAction = clang_IndexAction_create(Idx);
+
+  result = clang_IndexStore_indexSourceFile(store, idxAction, 0, argv + 1,
+                                            argc - 1,
+                                            getDefaultParsingOptions());
+  switch (result) {
+  case CXIndexStore_Indexed: printf("[index-store]: indexed\n"); break;
+  case CXIndexStore_UpToDate: printf("[index-store]: up-to-date\n"); break;
+  case CXIndexStore_Failure: printf("[index-store]: failure\n"); break;
+  }
+
+  clang_IndexAction_dispose(idxAction);
+  clang_disposeIndex(Idx);
+  clang_IndexStore_dispose(store);
+  return result == CXIndexStore_Failure ? -1 : 0;
+}
+
+static enum CXVisitorResult
+index_store_print_occurrence(void *context, const char *filename,
+                             unsigned line, unsigned column,
+                             int isDeclaration) {
+  printf("[%s]: %s:%u:%u\n", isDeclaration ? "declaration" : "reference",
+         filename, line, column);
+  return CXVisit_Continue;
+}
+
+static int index_store_find(int argc, const char **argv) {
+  CXIndexStore store;
+  CXResult result;
+
+  if (argc < 2) {
+    fprintf(stderr, "no index store or USR\n");
+    return -1;
+  }
+
+  if (!(store = clang_IndexStore_create(argv[0]))) {
+    fprintf(stderr, "Could not open index store '%s'\n", argv[0]);
+    return 1;
+  }
+  result = clang_IndexStore_findOccurrences(store, argv[1], 0,
+                                            index_store_print_occurrence);
+  clang_IndexStore_dispose(store);
+  return result == CXResult_Invalid ? -1 : 0;
+}
+
 int perform_token_annotation(int argc, const char **argv) {
   const char *input = argv[1];
   char *filename = 0;
@@ -3747,6 +3942,9 @@ static void print_usage(void) {
     "       c-index-test -index-file-full [-check-prefix=<FileCheck prefix>] <compiler arguments>\n"
     "       c-index-test -index-tu [-check-prefix=<FileCheck prefix>] <AST file>\n"
     "       c-index-test -index-compile-db [-check-prefix=<FileCheck prefix>] <compilation database>\n"
+    "       c-index-test -index-compile-db-batch [-check-prefix=<FileCheck prefix>] <compilation database>\n"
+    "       c-index-test -index-store-record <index store> <compiler arguments>\n"
+    "       c-index-test -index-store-find <index store> <USR>\n"
     "       c-index-test -test-file-scan <AST file> <source file> "
           "[FileCheck prefix]\n");
   fprintf(stderr,
@@ -3814,6 +4012,12 @@ int cindextest_main(int argc, const char **argv) {
     return index_tu(argc - 2, argv + 2);
   if (argc > 2 && strcmp(argv[1], "-index-compile-db") == 0)
     return index_compile_db(argc - 2, argv + 2);
+  if (argc > 2 && strcmp(argv[1], "-index-compile-db-batch") == 0)
+    return index_compile_db_batch(argc - 2, argv + 2);
+  if (argc > 2 && strcmp(argv[1], "-index-store-record") == 0)
+    return index_store_record(argc - 2, argv + 2);
+  if (argc > 2 && strcmp(argv[1], "-index-store-find") == 0)
+    return index_store_find(argc - 2, argv + 2);
   else if (argc >= 4 && strncmp(argv[1], "-test-load-tu", 13) == 0) {
     CXCursorVisitor I = GetVisitor(argv[1] + 13);
     if (I)
@@ -2770,6 +2770,9 @@ static void clang_parseTranslationUnit_Impl(void *UserData) {
       printDiagsToStderr(Unit ? Unit.get() : ErrUnit.get());
   }
 
+  if (Unit && (options & CXTranslationUnit_DeferPreambleRebuild))
+    Unit->setDeferPreambleRebuild(true);
+
   PTUI->result = MakeCXTranslationUnit(CXXIdx, Unit.take());
 }
 CXTranslationUnit clang_parseTranslationUnit(CXIndex CIdx,
@@ -2934,7 +2937,6 @@ static void clang_reparseTranslationUnit_Impl(void *UserData) {
   unsigned num_unsaved_files = RTUI->num_unsaved_files;
   struct CXUnsavedFile *unsaved_files = RTUI->unsaved_files;
   unsigned options = RTUI->options;
-  (void) options;
   RTUI->result = 1;
 
   CIndexer *CXXIdx = TU->CIdx;
@@ -2960,7 +2962,8 @@ static void clang_reparseTranslationUnit_Impl(void *UserData) {
   }
   
   if (!CXXUnit->Reparse(RemappedFiles->size() ? &(*RemappedFiles)[0] : 0,
-                        RemappedFiles->size()))
+                        RemappedFiles->size(),
+                        options & CXReparse_RebuildPreamble))
     RTUI->result = 0;
 }
 
@@ -2992,6 +2995,13 @@ int clang_reparseTranslationUnit(CXTranslationUnit TU,
   return RTUI.result;
 }
 
+unsigned clang_isPreambleStale(CXTranslationUnit TU) {
+  if (!TU)
+    return 0;
+
+  return cxtu::getASTUnit(TU)->isPreambleStale();
+}
+
 
 CXString clang_getTranslationUnitSpelling(CXTranslationUnit CTUnit) {
   if (!CTUnit)
@@ -6373,6 +6383,12 @@ const char *clang_getTUResourceUsageName(CXTUResourceUsageKind kind) {
     case CXTUResourceUsage_Preprocessor_HeaderSearch:
       str = "Preprocessor: header search tables";
       break;
+    case CXTUResourceUsage_AST_Stmts:
+      str = "ASTContext: statements and expressions (part of AST)";
+      break;
+    case CXTUResourceUsage_AST_TypeSourceInfo:
+      str = "ASTContext: type source info (part of AST)";
+      break;
   }
   return str;
 }
@@ -6402,6 +6418,14 @@ CXTUResourceUsage clang_getCXTUResourceUsage(CXTranslationUnit TU) {
   // How much memory is used by ASTContext's side tables?
   createCXTUResourceUsageEntry(*entries, CXTUResourceUsage_AST_SideTables,
     (unsigned long) astContext.getSideTableAllocatedMemory());
+
+  // How much of the AST memory is used by statements and expressions?
+  createCXTUResourceUsageEntry(*entries, CXTUResourceUsage_AST_Stmts,
+    (unsigned long) astContext.getStmtAllocatedMemory());
+
+  // How much of the AST memory is used by type source info?
+  createCXTUResourceUsageEntry(*entries, CXTUResourceUsage_AST_TypeSourceInfo,
+    (unsigned long) astContext.getTypeSourceInfoAllocatedMemory());
   
   // How much memory is used for caching global code completion results?
   unsigned long completionBytes = 0;
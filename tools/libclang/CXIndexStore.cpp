@@ -0,0 +1,570 @@
+//===- CXIndexStore.cpp - Persistent store of indexing results ------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements the CXIndexStore API, an on-disk store that maps the
+// USRs of indexed entities to their occurrences in source files.
+//
+// The store is a directory with two subdirectories:
+//
+//   records/ holds one file per indexed source file and translation unit.
+//            Its first line is the absolute path of the source file, its
+//            second line the name of the unit that wrote it, its third line
+//            a hash of the size, modification time and path of every file
+//            the translation unit depended on, followed by one line per
+//            occurrence: 'D' or 'R', line, column and USR.
+//
+//   units/   holds one file per indexed translation unit, named by an MD5
+//            hash of its arguments. It starts with the length of the
+//            arguments and the arguments themselves, followed by one line
+//            per dependency listing its size, modification time and path,
+//            an empty line, and the paths of the files it wrote records for.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang-c/Index.h"
+#include "clang/Basic/FileManager.h"
+#include "clang/Basic/LLVM.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/OwningPtr.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringSet.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/system_error.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+using namespace clang;
+
+namespace {
+
+/// \brief Identifies one version of a source file.
+struct FileStamp {
+  std::string Path;
+  uint64_t Size;
+  uint64_t ModTime;
+};
+
+/// \brief An occurrence of an entity in a source file.
+struct Occurrence {
+  unsigned Line;
+  unsigned Column;
+  bool IsDeclaration;
+  std::string USR;
+
+  bool operator<(const Occurrence &RHS) const {
+    if (Line != RHS.Line)
+      return Line < RHS.Line;
+    if (Column != RHS.Column)
+      return Column < RHS.Column;
+    if (IsDeclaration != RHS.IsDeclaration)
+      return IsDeclaration;
+    return USR < RHS.USR;
+  }
+
+  bool operator==(const Occurrence &RHS) const {
+    return Line == RHS.Line && Column == RHS.Column &&
+           IsDeclaration == RHS.IsDeclaration && USR == RHS.USR;
+  }
+};
+
+/// \brief The occurrences found in one source file.
+struct FileOccurrences {
+  std::string Path;
+  std::vector<Occurrence> Occurrences;
+};
+
+/// \brief Collects the dependencies and occurrences reported while indexing
+/// one translation unit.
+///
+/// File entries are only valid while the translation unit is alive, so
+/// everything needed to update the store is copied out of them.
+class StoreCollector {
+  llvm::DenseMap<const FileEntry *, unsigned> FileIndices;
+  llvm::SmallPtrSet<const FileEntry *, 32> SeenDependencies;
+
+public:
+  std::vector<FileStamp> Dependencies;
+  std::vector<FileOccurrences> Files;
+
+  void addDependency(CXFile File) {
+    const FileEntry *FE = static_cast<const FileEntry *>(File);
+    if (FE && SeenDependencies.insert(FE))
+      Dependencies.push_back(getStamp(FE));
+  }
+
+  void addOccurrence(const char *USR, CXIdxLoc Loc, bool IsDeclaration) {
+    if (!USR || !*USR)
+      return;
+
+    CXFile File;
+    unsigned Line, Column;
+    clang_indexLoc_getFileLocation(Loc, /*indexFile=*/0, &File, &Line, &Column,
+                                   /*offset=*/0);
+    if (!File)
+      return;
+
+    const FileEntry *FE = static_cast<const FileEntry *>(File);
+    std::pair<llvm::DenseMap<const FileEntry *, unsigned>::iterator, bool>
+      Known = FileIndices.insert(std::make_pair(FE, Files.size()));
+    if (Known.second) {
+      Files.push_back(FileOccurrences());
+      Files.back().Path = getStamp(FE).Path;
+    }
+
+    Occurrence O;
+    O.Line = Line;
+    O.Column = Column;
+    O.IsDeclaration = IsDeclaration;
+    O.USR = USR;
+    Files[Known.first->second].Occurrences.push_back(O);
+  }
+
+  /// \brief Compute a key that identifies the versions of all of the files
+  /// the translation unit depended on.
+  ///
+  /// The occurrences in a file also depend on the files it includes (and on
+  /// the files included before it), so a record is only reused if all of
+  /// these are unchanged.
+  std::string getDependencyKey() const {
+    llvm::MD5 Hash;
+    for (unsigned I = 0, N = Dependencies.size(); I != N; ++I) {
+      const FileStamp &Dep = Dependencies[I];
+      std::string Line;
+      llvm::raw_string_ostream OS(Line);
+      OS << Dep.Size << ' ' << Dep.ModTime << ' ' << Dep.Path << '\n';
+      Hash.update(OS.str());
+    }
+    llvm::MD5::MD5Result Result;
+    Hash.final(Result);
+    SmallString<32> Key;
+    llvm::MD5::stringifyResult(Result, Key);
+    return Key.str();
+  }
+
+private:
+  static FileStamp getStamp(const FileEntry *FE) {
+    SmallString<256> Path(FE->getName());
+    llvm::sys::fs::make_absolute(Path);
+
+    FileStamp Stamp;
+    Stamp.Path = Path.str();
+    Stamp.Size = FE->getSize();
+    Stamp.ModTime = FE->getModificationTime();
+    return Stamp;
+  }
+};
+
+/// \brief Write \p Contents to \p Path through a temporary file, so that
+/// concurrent readers never observe a partially written file.
+static bool writeFileAtomically(StringRef Path, StringRef Contents) {
+  SmallString<256> TempPath(Path);
+  TempPath += "-%%%%%%%%";
+  int FD;
+  if (llvm::sys::fs::createUniqueFile(TempPath.str(), FD, TempPath))
+    return false;
+
+  {
+    llvm::raw_fd_ostream OS(FD, /*shouldClose=*/true);
+    OS << Contents;
+    OS.close();
+    if (OS.has_error()) {
+      OS.clear_error();
+      bool Existed;
+      llvm::sys::fs::remove(TempPath.str(), Existed);
+      return false;
+    }
+  }
+
+  if (llvm::sys::fs::rename(TempPath.str(), Path)) {
+    bool Existed;
+    llvm::sys::fs::remove(TempPath.str(), Existed);
+    return false;
+  }
+  return true;
+}
+
+/// \brief Split off the first line of \p Buffer.
+static StringRef takeLine(StringRef &Buffer) {
+  std::pair<StringRef, StringRef> Split = Buffer.split('\n');
+  Buffer = Split.second;
+  return Split.first;
+}
+
+/// \brief Parse a "<size> <mtime>" prefix of \p Line, returning the rest of
+/// the line in \p Rest.
+static bool parseStamp(StringRef Line, uint64_t &Size, uint64_t &ModTime,
+                       StringRef &Rest) {
+  std::pair<StringRef, StringRef> SizeSplit = Line.split(' ');
+  std::pair<StringRef, StringRef> TimeSplit = SizeSplit.second.split(' ');
+  Rest = TimeSplit.second;
+  return !SizeSplit.first.getAsInteger(10, Size) &&
+         !TimeSplit.first.getAsInteger(10, ModTime);
+}
+
+/// \brief Compute the MD5 hash of \p Str as a hexadecimal string.
+static std::string getMD5Hex(StringRef Str) {
+  llvm::MD5 Hash;
+  Hash.update(Str);
+  llvm::MD5::MD5Result Result;
+  Hash.final(Result);
+  SmallString<32> Hex;
+  llvm::MD5::stringifyResult(Result, Hex);
+  return Hex.str();
+}
+
+/// \brief The contents of a unit file.
+struct UnitInfo {
+  /// \brief The files the translation unit depended on.
+  std::vector<FileStamp> Dependencies;
+
+  /// \brief The source files the translation unit wrote records for.
+  std::vector<std::string> RecordFiles;
+};
+
+class IndexStore {
+  std::string RecordsDir;
+  std::string UnitsDir;
+
+public:
+  explicit IndexStore(StringRef Path) {
+    SmallString<256> Dir(Path);
+    llvm::sys::path::append(Dir, "records");
+    RecordsDir = Dir.str();
+    Dir = Path;
+    llvm::sys::path::append(Dir, "units");
+    UnitsDir = Dir.str();
+  }
+
+  bool initialize() {
+    bool Existed;
+    return !llvm::sys::fs::create_directories(RecordsDir, Existed) &&
+           !llvm::sys::fs::create_directories(UnitsDir, Existed);
+  }
+
+  /// \brief Compute the key that identifies a translation unit built with
+  /// the given arguments in the current working directory.
+  static std::string getUnitKey(const char *SourceFilename,
+                                const char * const *Args, int NumArgs) {
+    SmallString<256> Key;
+    llvm::sys::fs::current_path(Key);
+    if (SourceFilename) {
+      Key += '\0';
+      Key += SourceFilename;
+    }
+    for (int I = 0; I != NumArgs; ++I) {
+      Key += '\0';
+      Key += Args[I];
+    }
+    return Key.str();
+  }
+
+  /// \brief Compute the path of the unit file for the given unit key.
+  std::string getUnitPath(StringRef UnitKey) const {
+    SmallString<256> Path(UnitsDir);
+    llvm::sys::path::append(Path, getMD5Hex(UnitKey));
+    return Path.str();
+  }
+
+  /// \brief Read the unit file at \p UnitPath.
+  ///
+  /// \returns false if the file is missing or malformed, or if it was written
+  /// for a unit with a different key.
+  static bool readUnit(StringRef UnitPath, StringRef UnitKey, UnitInfo &Unit) {
+    OwningPtr<llvm::MemoryBuffer> Buffer;
+    if (llvm::MemoryBuffer::getFile(UnitPath, Buffer))
+      return false;
+
+    // The key may contain newlines, so it is stored after its length.
+    StringRef Contents = Buffer->getBuffer();
+    uint64_t KeyLength;
+    if (takeLine(Contents).getAsInteger(10, KeyLength) ||
+        KeyLength != UnitKey.size() || !Contents.startswith(UnitKey))
+      return false;
+    Contents = Contents.drop_front(KeyLength);
+    if (!Contents.startswith("\n"))
+      return false;
+    Contents = Contents.drop_front(1);
+
+    // The dependencies are separated from the record files by an empty line.
+    while (!Contents.empty()) {
+      StringRef Line = takeLine(Contents);
+      if (Line.empty())
+        break;
+
+      FileStamp Dep;
+      StringRef Path;
+      if (!parseStamp(Line, Dep.Size, Dep.ModTime, Path))
+        return false;
+      Dep.Path = Path;
+      Unit.Dependencies.push_back(Dep);
+    }
+    while (!Contents.empty())
+      Unit.RecordFiles.push_back(takeLine(Contents));
+    return !Unit.Dependencies.empty();
+  }
+
+  /// \brief Determine whether none of the files the given unit depended on
+  /// changed since the unit was written.
+  static bool isUnitUpToDate(const UnitInfo &Unit) {
+    for (unsigned I = 0, N = Unit.Dependencies.size(); I != N; ++I) {
+      const FileStamp &Dep = Unit.Dependencies[I];
+      llvm::sys::fs::file_status Status;
+      if (llvm::sys::fs::status(Dep.Path, Status) ||
+          Status.getSize() != Dep.Size ||
+          Status.getLastModificationTime().toEpochTime() != Dep.ModTime)
+        return false;
+    }
+    return true;
+  }
+
+  static bool writeUnit(StringRef UnitPath, StringRef UnitKey,
+                        const StoreCollector &Collector) {
+    std::string Contents;
+    llvm::raw_string_ostream OS(Contents);
+    OS << UnitKey.size() << '\n' << UnitKey << '\n';
+    for (unsigned I = 0, N = Collector.Dependencies.size(); I != N; ++I) {
+      const FileStamp &Dep = Collector.Dependencies[I];
+      OS << Dep.Size << ' ' << Dep.ModTime << ' ' << Dep.Path << '\n';
+    }
+    OS << '\n';
+    for (unsigned I = 0, N = Collector.Files.size(); I != N; ++I)
+      OS << Collector.Files[I].Path << '\n';
+    return writeFileAtomically(UnitPath, OS.str());
+  }
+
+  /// \brief Write the records of the unit at \p UnitPath, skipping files
+  /// whose record was produced from the same versions of all dependencies.
+  ///
+  /// Each unit owns its own record of every file it has occurrences in, so
+  /// units that see a shared header in different configurations do not
+  /// overwrite each other. Records \p OldUnit wrote for files that no longer
+  /// have any occurrences are removed; those of other units are kept.
+  bool writeRecords(StringRef UnitPath, StoreCollector &Collector,
+                    const UnitInfo &OldUnit) const {
+    bool Success = true;
+    StringRef UnitName = llvm::sys::path::filename(UnitPath);
+    std::string Key = Collector.getDependencyKey();
+    llvm::StringSet<> Written;
+    for (unsigned I = 0, N = Collector.Files.size(); I != N; ++I) {
+      FileOccurrences &File = Collector.Files[I];
+      Written.insert(File.Path);
+      std::string RecordPath = getRecordPath(File.Path, UnitName);
+      if (isRecordUpToDate(RecordPath, File.Path, UnitName, Key))
+        continue;
+
+      std::vector<Occurrence> &Occurrences = File.Occurrences;
+      std::sort(Occurrences.begin(), Occurrences.end());
+      Occurrences.erase(std::unique(Occurrences.begin(), Occurrences.end()),
+                        Occurrences.end());
+
+      std::string Contents;
+      llvm::raw_string_ostream OS(Contents);
+      OS << File.Path << '\n' << UnitName << '\n' << Key << '\n';
+      for (unsigned J = 0, M = Occurrences.size(); J != M; ++J) {
+        const Occurrence &O = Occurrences[J];
+        OS << (O.IsDeclaration ? 'D' : 'R') << ' ' << O.Line << ' '
+           << O.Column << ' ' << O.USR << '\n';
+      }
+      if (!writeFileAtomically(RecordPath, OS.str()))
+        Success = false;
+    }
+
+    for (unsigned I = 0, N = OldUnit.RecordFiles.size(); I != N; ++I) {
+      const std::string &FilePath = OldUnit.RecordFiles[I];
+      if (Written.count(FilePath))
+        continue;
+      bool Existed;
+      if (llvm::sys::fs::remove(getRecordPath(FilePath, UnitName), Existed))
+        Success = false;
+    }
+    return Success;
+  }
+
+  /// \brief Visit the occurrences of \p USR in all records, in order of file
+  /// path and position. An occurrence recorded by several units is visited
+  /// once.
+  CXResult findOccurrences(StringRef USR, void *Context,
+                           CXIndexStoreOccurrenceVisitor Visitor) const {
+    typedef std::pair<std::string, Occurrence> FoundOccurrence;
+    std::vector<FoundOccurrence> Found;
+
+    llvm::error_code EC;
+    for (llvm::sys::fs::directory_iterator Dir(RecordsDir, EC), DirEnd;
+         Dir != DirEnd && !EC; Dir.increment(EC)) {
+      OwningPtr<llvm::MemoryBuffer> Buffer;
+      if (llvm::MemoryBuffer::getFile(Dir->path(), Buffer))
+        continue;
+
+      StringRef Contents = Buffer->getBuffer();
+      StringRef FilePath = takeLine(Contents);
+      takeLine(Contents); // Skip the unit name.
+      takeLine(Contents); // Skip the dependency key.
+      while (!Contents.empty()) {
+        StringRef Line = takeLine(Contents);
+        if (Line.size() < 2)
+          continue;
+
+        uint64_t LineNo, Column;
+        StringRef OccurrenceUSR;
+        if (!parseStamp(Line.substr(2), LineNo, Column, OccurrenceUSR) ||
+            OccurrenceUSR != USR)
+          continue;
+
+        Occurrence O;
+        O.Line = LineNo;
+        O.Column = Column;
+        O.IsDeclaration = Line[0] == 'D';
+        Found.push_back(std::make_pair(FilePath.str(), O));
+      }
+    }
+
+    std::sort(Found.begin(), Found.end());
+    Found.erase(std::unique(Found.begin(), Found.end()), Found.end());
+    for (unsigned I = 0, N = Found.size(); I != N; ++I) {
+      const Occurrence &O = Found[I].second;
+      if (Visitor(Context, Found[I].first.c_str(), O.Line, O.Column,
+                  O.IsDeclaration) == CXVisit_Break)
+        return CXResult_VisitBreak;
+    }
+    return CXResult_Success;
+  }
+
+private:
+  /// \brief Compute the path of the record that the unit \p UnitName owns
+  /// for the source file \p FilePath.
+  std::string getRecordPath(StringRef FilePath, StringRef UnitName) const {
+    SmallString<256> Key(FilePath);
+    Key += '\0';
+    Key += UnitName;
+
+    SmallString<256> Path(RecordsDir);
+    llvm::sys::path::append(Path, llvm::sys::path::filename(FilePath) + "-" +
+                                    getMD5Hex(Key.str()));
+    return Path.str();
+  }
+
+  static bool isRecordUpToDate(StringRef RecordPath, StringRef FilePath,
+                               StringRef UnitName, StringRef Key) {
+    OwningPtr<llvm::MemoryBuffer> Buffer;
+    if (llvm::MemoryBuffer::getFile(RecordPath, Buffer))
+      return false;
+
+    StringRef Contents = Buffer->getBuffer();
+    return takeLine(Contents) == FilePath && takeLine(Contents) == UnitName &&
+           takeLine(Contents) == Key;
+  }
+};
+
+} // anonymous namespace
+
+static CXIdxClientFile storeEnteredMainFile(CXClientData client_data,
+                                            CXFile file, void *reserved) {
+  static_cast<StoreCollector *>(client_data)->addDependency(file);
+  return 0;
+}
+
+static CXIdxClientFile storePPIncludedFile(CXClientData client_data,
+                                           const CXIdxIncludedFileInfo *info) {
+  static_cast<StoreCollector *>(client_data)->addDependency(info->file);
+  return 0;
+}
+
+static void storeIndexDeclaration(CXClientData client_data,
+                                  const CXIdxDeclInfo *info) {
+  static_cast<StoreCollector *>(client_data)
+    ->addOccurrence(info->entityInfo->USR, info->loc, /*IsDeclaration=*/true);
+}
+
+static void storeIndexEntityReference(CXClientData client_data,
+                                      const CXIdxEntityRefInfo *info) {
+  static_cast<StoreCollector *>(client_data)
+    ->addOccurrence(info->referencedEntity->USR, info->loc,
+                    /*IsDeclaration=*/false);
+}
+
+extern "C" {
+
+CXIndexStore clang_IndexStore_create(const char *path) {
+  if (!path)
+    return 0;
+
+  IndexStore *Store = new IndexStore(path);
+  if (!Store->initialize()) {
+    delete Store;
+    return 0;
+  }
+  return Store;
+}
+
+void clang_IndexStore_dispose(CXIndexStore CStore) {
+  delete static_cast<IndexStore *>(CStore);
+}
+
+CXIndexStoreResult
+clang_IndexStore_indexSourceFile(CXIndexStore CStore, CXIndexAction idxAction,
+                                 const char *source_filename,
+                                 const char * const *command_line_args,
+                                 int num_command_line_args,
+                                 unsigned TU_options) {
+  if (!CStore || !idxAction)
+    return CXIndexStore_Failure;
+
+  IndexStore *Store = static_cast<IndexStore *>(CStore);
+  std::string UnitKey = IndexStore::getUnitKey(source_filename,
+                                               command_line_args,
+                                               num_command_line_args);
+  std::string UnitPath = Store->getUnitPath(UnitKey);
+  UnitInfo OldUnit;
+  if (IndexStore::readUnit(UnitPath, UnitKey, OldUnit) &&
+      IndexStore::isUnitUpToDate(OldUnit))
+    return CXIndexStore_UpToDate;
+
+  IndexerCallbacks CB;
+  memset(&CB, 0, sizeof(CB));
+  CB.enteredMainFile = storeEnteredMainFile;
+  CB.ppIncludedFile = storePPIncludedFile;
+  CB.indexDeclaration = storeIndexDeclaration;
+  CB.indexEntityReference = storeIndexEntityReference;
+
+  // Every occurrence is needed, so neither skip bodies nor suppress
+  // redundant references.
+  StoreCollector Collector;
+  if (clang_indexSourceFile(idxAction, &Collector, &CB, sizeof(CB),
+                            CXIndexOpt_None, source_filename,
+                            command_line_args, num_command_line_args,
+                            /*unsaved_files=*/0, /*num_unsaved_files=*/0,
+                            /*out_TU=*/0, TU_options))
+    return CXIndexStore_Failure;
+
+  // Write the records first, so that a unit is never considered up-to-date
+  // while the records of its files are missing.
+  if (!Store->writeRecords(UnitPath, Collector, OldUnit) ||
+      !IndexStore::writeUnit(UnitPath, UnitKey, Collector))
+    return CXIndexStore_Failure;
+
+  return CXIndexStore_Indexed;
+}
+
+CXResult clang_IndexStore_findOccurrences(CXIndexStore CStore, const char *USR,
+                                         void *context,
+                                         CXIndexStoreOccurrenceVisitor visitor) {
+  if (!CStore || !USR || !visitor)
+    return CXResult_Invalid;
+
+  return static_cast<IndexStore *>(CStore)->findOccurrences(USR, context,
+                                                            visitor);
+}
+
+} // end: extern "C"
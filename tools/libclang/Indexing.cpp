@@ -17,6 +17,7 @@
 #include "CXTranslationUnit.h"
 #include "clang/AST/ASTConsumer.h"
 #include "clang/AST/DeclVisitor.h"
+#include "clang/Basic/FileSystemStatCache.h"
 #include "clang/Frontend/ASTUnit.h"
 #include "clang/Frontend/CompilerInstance.h"
 #include "clang/Frontend/CompilerInvocation.h"
@@ -28,9 +29,11 @@
 #include "clang/Lex/Preprocessor.h"
 #include "clang/Sema/SemaConsumer.h"
 #include "llvm/Support/CrashRecoveryContext.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Mutex.h"
 #include "llvm/Support/MutexGuard.h"
+#include "llvm/Support/Path.h"
 #include <cstdio>
 
 using namespace clang;
@@ -402,6 +405,77 @@ public:
   }
 };
 
+//===----------------------------------------------------------------------===//
+// Shared Stat Cache
+//===----------------------------------------------------------------------===//
+
+/// \brief The 'stat' results collected while indexing a batch of compile
+/// commands, shared by the file managers of all translation units in the
+/// batch.
+class BatchStatCacheData {
+  llvm::sys::Mutex Mux;
+  llvm::StringMap<FileData> StatCalls;
+  unsigned NumHits;
+
+public:
+  BatchStatCacheData() : Mux(/*recursive=*/false), NumHits(0) {}
+
+  bool lookup(StringRef Path, FileData &Data) {
+    llvm::MutexGuard MG(Mux);
+    llvm::StringMap<FileData>::iterator I = StatCalls.find(Path);
+    if (I == StatCalls.end())
+      return false;
+    Data = I->second;
+    ++NumHits;
+    return true;
+  }
+
+  void insert(StringRef Path, const FileData &Data) {
+    llvm::MutexGuard MG(Mux);
+    StatCalls[Path] = Data;
+  }
+
+  /// \brief The number of 'stat' calls answered from the shared results.
+  unsigned getNumHits() {
+    llvm::MutexGuard MG(Mux);
+    return NumHits;
+  }
+};
+
+/// \brief A stat cache that consults and populates a \c BatchStatCacheData.
+///
+/// Only successful lookups are shared. The commands of a batch may run in
+/// different working directories, so relative paths are shared under the
+/// absolute path they resolve to.
+class BatchStatCache : public FileSystemStatCache {
+  BatchStatCacheData &SharedData;
+  std::string WorkingDir;
+
+public:
+  BatchStatCache(BatchStatCacheData &sharedData, StringRef workingDir)
+    : SharedData(sharedData) {
+    SmallString<256> Dir(workingDir);
+    llvm::sys::fs::make_absolute(Dir);
+    WorkingDir = Dir.str();
+  }
+
+  virtual LookupResult getStat(const char *Path, FileData &Data, bool isFile,
+                               int *FileDescriptor) {
+    SmallString<256> Key(Path);
+    if (!llvm::sys::path::is_absolute(Key)) {
+      Key = WorkingDir;
+      llvm::sys::path::append(Key, Path);
+    }
+    if (SharedData.lookup(Key, Data))
+      return CacheExists;
+
+    LookupResult Result = statChained(Path, Data, isFile, FileDescriptor);
+    if (Result == CacheExists)
+      SharedData.insert(Key, Data);
+    return Result;
+  }
+};
+
 //===----------------------------------------------------------------------===//
 // IndexingFrontendAction
 //===----------------------------------------------------------------------===//
@@ -484,6 +558,7 @@ struct IndexSourceFileInfo {
   unsigned num_unsaved_files;
   CXTranslationUnit *out_TU;
   unsigned TU_options;
+  BatchStatCacheData *stat_cache_data;
   int result;
 };
 
@@ -514,6 +589,7 @@ static void clang_indexSourceFile_Impl(void *UserData) {
   unsigned num_unsaved_files = ITUI->num_unsaved_files;
   CXTranslationUnit *out_TU  = ITUI->out_TU;
   unsigned TU_options = ITUI->TU_options;
+  BatchStatCacheData *stat_cache_data = ITUI->stat_cache_data;
   ITUI->result = 1; // init as error.
   
   if (out_TU)
@@ -612,6 +688,11 @@ static void clang_indexSourceFile_Impl(void *UserData) {
   ASTUnit *Unit = ASTUnit::create(CInvok.getPtr(), Diags,
                                   CaptureDiagnostics,
                                   /*UserFilesAreVolatile=*/true);
+  if (stat_cache_data) {
+    FileManager &FileMgr = Unit->getFileManager();
+    FileMgr.addStatCache(new BatchStatCache(
+        *stat_cache_data, FileMgr.getFileSystemOptions().WorkingDir));
+  }
   OwningPtr<CXTUOwner> CXTU(new CXTUOwner(MakeCXTranslationUnit(CXXIdx, Unit)));
 
   // Recover resources if we crash before exiting this method.
@@ -680,6 +761,47 @@ static void clang_indexSourceFile_Impl(void *UserData) {
   ITUI->result = 0; // success.
 }
 
+/// \brief Index a source file on a crash-recovery thread, reporting the
+/// arguments of the failing invocation if indexing crashed.
+static int indexSourceFileSafely(IndexSourceFileInfo &ITUI) {
+  if (getenv("LIBCLANG_NOTHREADS")) {
+    clang_indexSourceFile_Impl(&ITUI);
+    return ITUI.result;
+  }
+
+  llvm::CrashRecoveryContext CRC;
+
+  if (!RunSafely(CRC, clang_indexSourceFile_Impl, &ITUI)) {
+    fprintf(stderr, "libclang: crash detected during indexing source file: {\n");
+    fprintf(stderr, "  'source_filename' : '%s'\n",
+            ITUI.source_filename ? ITUI.source_filename : "");
+    fprintf(stderr, "  'command_line_args' : [");
+    for (int i = 0; i != ITUI.num_command_line_args; ++i) {
+      if (i)
+        fprintf(stderr, ", ");
+      fprintf(stderr, "'%s'", ITUI.command_line_args[i]);
+    }
+    fprintf(stderr, "],\n");
+    fprintf(stderr, "  'unsaved_files' : [");
+    for (unsigned i = 0; i != ITUI.num_unsaved_files; ++i) {
+      if (i)
+        fprintf(stderr, ", ");
+      fprintf(stderr, "('%s', '...', %ld)", ITUI.unsaved_files[i].Filename,
+              ITUI.unsaved_files[i].Length);
+    }
+    fprintf(stderr, "],\n");
+    fprintf(stderr, "  'options' : %d,\n", ITUI.TU_options);
+    fprintf(stderr, "}\n");
+    
+    return 1;
+  } else if (getenv("LIBCLANG_RESOURCE_USAGE")) {
+    if (ITUI.out_TU)
+      PrintLibclangResourceUsage(*ITUI.out_TU);
+  }
+  
+  return ITUI.result;
+}
+
 //===----------------------------------------------------------------------===//
 // clang_indexTranslationUnit Implementation
 //===----------------------------------------------------------------------===//
@@ -979,43 +1101,64 @@ int clang_indexSourceFile(CXIndexAction idxAction,
                                index_callbacks_size, index_options,
                                source_filename, command_line_args,
                                num_command_line_args, unsaved_files,
-                               num_unsaved_files, out_TU, TU_options, 0 };
+                               num_unsaved_files, out_TU, TU_options, 0, 0 };
+  return indexSourceFileSafely(ITUI);
+}
 
-  if (getenv("LIBCLANG_NOTHREADS")) {
-    clang_indexSourceFile_Impl(&ITUI);
-    return ITUI.result;
+unsigned clang_indexCompileCommandsSerially(CXIndexAction idxAction,
+                                           CXClientData client_data,
+                                           IndexerCallbacks *index_callbacks,
+                                           unsigned index_callbacks_size,
+                                           unsigned index_options,
+                                           CXCompileCommands commands,
+                                           unsigned TU_options) {
+  unsigned NumCommands = clang_CompileCommands_getSize(commands);
+  LOG_FUNC_SECTION {
+    *Log << NumCommands << " commands";
   }
 
-  llvm::CrashRecoveryContext CRC;
-
-  if (!RunSafely(CRC, clang_indexSourceFile_Impl, &ITUI)) {
-    fprintf(stderr, "libclang: crash detected during indexing source file: {\n");
-    fprintf(stderr, "  'source_filename' : '%s'\n", source_filename);
-    fprintf(stderr, "  'command_line_args' : [");
-    for (int i = 0; i != num_command_line_args; ++i) {
-      if (i)
-        fprintf(stderr, ", ");
-      fprintf(stderr, "'%s'", command_line_args[i]);
+  BatchStatCacheData StatCacheData;
+  unsigned NumFailed = 0;
+  for (unsigned I = 0; I != NumCommands; ++I) {
+    CXCompileCommand Cmd = clang_CompileCommands_getCommand(commands, I);
+    unsigned NumArgs = clang_CompileCommand_getNumArgs(Cmd);
+
+    // Run the command in its own working directory, and drop the name of the
+    // compiler executable, which is not part of the arguments expected by
+    // clang_indexSourceFile.
+    SmallVector<std::string, 32> ArgStrs;
+    CXString Dir = clang_CompileCommand_getDirectory(Cmd);
+    if (const char *DirStr = clang_getCString(Dir)) {
+      if (*DirStr) {
+        ArgStrs.push_back("-working-directory");
+        ArgStrs.push_back(DirStr);
+      }
     }
-    fprintf(stderr, "],\n");
-    fprintf(stderr, "  'unsaved_files' : [");
-    for (unsigned i = 0; i != num_unsaved_files; ++i) {
-      if (i)
-        fprintf(stderr, ", ");
-      fprintf(stderr, "('%s', '...', %ld)", unsaved_files[i].Filename,
-              unsaved_files[i].Length);
+    clang_disposeString(Dir);
+    for (unsigned A = 1; A < NumArgs; ++A) {
+      CXString Arg = clang_CompileCommand_getArg(Cmd, A);
+      ArgStrs.push_back(clang_getCString(Arg));
+      clang_disposeString(Arg);
     }
-    fprintf(stderr, "],\n");
-    fprintf(stderr, "  'options' : %d,\n", TU_options);
-    fprintf(stderr, "}\n");
-    
-    return 1;
-  } else if (getenv("LIBCLANG_RESOURCE_USAGE")) {
-    if (out_TU)
-      PrintLibclangResourceUsage(*out_TU);
+
+    SmallVector<const char *, 32> Args;
+    for (unsigned A = 0, N = ArgStrs.size(); A != N; ++A)
+      Args.push_back(ArgStrs[A].c_str());
+
+    IndexSourceFileInfo ITUI = { idxAction, client_data, index_callbacks,
+                                 index_callbacks_size, index_options,
+                                 /*source_filename=*/0, Args.data(),
+                                 static_cast<int>(Args.size()),
+                                 /*unsaved_files=*/0, /*num_unsaved_files=*/0,
+                                 /*out_TU=*/0, TU_options, &StatCacheData, 0 };
+    if (indexSourceFileSafely(ITUI))
+      ++NumFailed;
   }
-  
-  return ITUI.result;
+
+  LOG_FUNC_SECTION {
+    *Log << StatCacheData.getNumHits() << " stat results reused";
+  }
+  return NumFailed;
 }
 
 int clang_indexTranslationUnit(CXIndexAction idxAction,